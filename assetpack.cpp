@@ -0,0 +1,114 @@
+#include "assetpack.h"
+#include "config.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QDebug>
+#include <QtEndian>
+
+namespace {
+    quint32 readU32(const uchar *p) { return qFromLittleEndian<quint32>(p); }
+    quint16 readU16(const uchar *p) { return qFromLittleEndian<quint16>(p); }
+}
+
+// AssetPack - Mapped on first use; the mapping is never released
+AssetPack& AssetPack::instance()
+{
+    static AssetPack instance;
+    return instance;
+}
+
+AssetPack::AssetPack()
+    : m_base(nullptr)
+    , m_size(0)
+    , m_count(0)
+{
+    const QString path = QCoreApplication::applicationDirPath() + "/" + Config::ASSET_PACK_FILE;
+    if (!open(path)) {
+        qDebug() << "Asset pack unavailable:" << path;
+    }
+}
+
+AssetPack::~AssetPack() = default;
+
+bool AssetPack::open(const QString &path)
+{
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly) || file->size() < HEADER_SIZE) return false;
+
+    const uchar *base = file->map(0, file->size());
+    if (!base) return false;
+
+    const quint32 count = readU32(base + 8);
+    if (readU32(base) != MAGIC || readU16(base + 4) != VERSION
+        || readU32(base + 12) != static_cast<quint32>(file->size())
+        || HEADER_SIZE + qint64(count) * ENTRY_SIZE > file->size()) {
+        qDebug() << "Ignoring incompatible asset pack:" << path;
+        return false;
+    }
+
+    // Every entry must point inside the file before anything is handed out
+    for (quint32 slot = 0; slot < count; ++slot) {
+        const uchar *entry = base + HEADER_SIZE + slot * ENTRY_SIZE;
+        if (qint64(readU32(entry)) + readU32(entry + 4) > file->size()
+            || qint64(readU32(entry + 8)) + readU32(entry + 12) > file->size()) {
+            qDebug() << "Asset pack index is corrupt:" << path;
+            return false;
+        }
+    }
+
+    m_file = std::move(file);
+    m_base = base;
+    m_size = m_file->size();
+    m_count = count;
+    return true;
+}
+
+QByteArrayView AssetPack::nameAt(quint32 slot) const
+{
+    const uchar *entry = m_base + HEADER_SIZE + slot * ENTRY_SIZE;
+    return QByteArrayView(reinterpret_cast<const char *>(m_base + readU32(entry)), readU32(entry + 4));
+}
+
+qint64 AssetPack::find(QByteArrayView name) const
+{
+    quint32 low = 0;
+    quint32 high = m_count;
+    while (low < high) {
+        const quint32 mid = low + (high - low) / 2;
+        const int order = nameAt(mid).compare(name);
+        if (order == 0) return mid;
+        if (order < 0) low = mid + 1;
+        else high = mid;
+    }
+    return -1;
+}
+
+bool AssetPack::contains(const QString &name) const
+{
+    return m_base && find(name.toUtf8()) >= 0;
+}
+
+QByteArray AssetPack::data(const QString &name) const
+{
+    if (!m_base) return QByteArray();
+
+    const qint64 slot = find(name.toUtf8());
+    if (slot < 0) return QByteArray();
+
+    const uchar *entry = m_base + HEADER_SIZE + slot * ENTRY_SIZE;
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_base + readU32(entry + 8)),
+                                   readU32(entry + 12));
+}
+
+QStringList AssetPack::names(const QString &prefix) const
+{
+    QStringList result;
+    const QByteArray utf8Prefix = prefix.toUtf8();
+    for (quint32 slot = 0; slot < m_count; ++slot) {
+        const QByteArrayView name = nameAt(slot);
+        if (name.startsWith(utf8Prefix)) {
+            result.append(QString::fromUtf8(name));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QFile;
+QT_END_NAMESPACE
+
+// AssetPack - Read-only view of the memory-mapped asset pack
+//
+// The pack is written by the assetpack build tool from the files listed in
+// resources.qrc and installed next to the executable. It is mapped once;
+// data() returns QByteArray::fromRawData views into the mapping, so no
+// asset is ever copied onto the heap and only the pages that are actually
+// read get faulted in.
+//
+// Layout (little endian):
+//   header   magic u32, version u16, alignment u16, count u32, file size u32
+//   index    count x {name offset u32, name length u32, data offset u32, data size u32},
+//            sorted by the UTF-8 bytes of the name
+//   names    concatenated UTF-8 names
+//   data     uncompressed payloads, each starting on an ALIGNMENT boundary
+class AssetPack
+{
+public:
+    static constexpr quint32 MAGIC = 0x50414250;  // "PBAP"
+    static constexpr quint16 VERSION = 1;
+    static constexpr int ALIGNMENT = 64;
+    static constexpr int HEADER_SIZE = 16;
+    static constexpr int ENTRY_SIZE = 16;
+
+    static AssetPack& instance();
+
+    bool isAvailable() const { return m_base != nullptr; }
+    bool contains(const QString &name) const;
+
+    // Zero-copy view that stays valid for the lifetime of the process; empty if missing
+    QByteArray data(const QString &name) const;
+
+    // Names of every asset whose name starts with prefix, in pack order
+    QStringList names(const QString &prefix = QString()) const;
+
+private:
+    AssetPack();
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const QString &path);
+    QByteArrayView nameAt(quint32 slot) const;
+    qint64 find(QByteArrayView name) const;
+
+    std::unique_ptr<QFile> m_file;
+    const uchar *m_base;
+    qint64 m_size;
+    quint32 m_count;
+};
+
+#endif // ASSETPACK_H
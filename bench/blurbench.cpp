@@ -0,0 +1,137 @@
+// blurbench - BlurEngine throughput per kernel set and thread count vs QGraphicsBlurEffect
+//
+// Each size is blurred --iterations times after one warm-up run and reported
+// as megapixels per second of source image. Every BlurEngine row is also
+// compared with the scalar result; "identical" must hold for all of them.
+//
+// QGraphicsBlurEffect is timed the way Qt uses it: a pixmap item with the
+// effect rendered through a QGraphicsScene, with blurRadius = 3 * sigma so
+// both blurs have roughly the same support. Its pixels are not compared.
+//
+// Run with -platform offscreen on headless machines.
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGraphicsBlurEffect>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThreadPool>
+#include <algorithm>
+#include <functional>
+#include "blurengine.h"
+
+namespace {
+    // Noise under a few shapes, premultiplied, so edges and flat areas are both exercised
+    QImage testImage(const QSize &size)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        QRandomGenerator random(42);
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                line[x] = qPremultiply(random.generate());
+            }
+        }
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setBrush(QColor(40, 90, 200, 180));
+        painter.drawEllipse(QRectF(QPointF(0, 0), size).adjusted(size.width() / 4, size.height() / 4,
+                                                                -size.width() / 4, -size.height() / 4));
+        return image;
+    }
+
+    double megapixelsPerSecond(const QSize &size, int iterations, const std::function<void()> &run)
+    {
+        run();
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            run();
+        }
+        const double seconds = timer.nsecsElapsed() / 1e9;
+        return double(size.width()) * size.height() * iterations / 1e6 / seconds;
+    }
+
+    QSize parseSize(const QString &text)
+    {
+        const QStringList parts = text.split('x');
+        return parts.size() == 2 ? QSize(parts.at(0).toInt(), parts.at(1).toInt()) : QSize();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("BlurEngine throughput vs QGraphicsBlurEffect");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"sizes", "Comma-separated image sizes.", "WxH,...", "256x256,1100x720,3840x2160"},
+        {"sigma", "Gaussian sigma in pixels.", "sigma", "8"},
+        {"iterations", "Timed blurs per case.", "count", "10"},
+    });
+    parser.process(app);
+
+    const qreal sigma = parser.value("sigma").toDouble();
+    const int iterations = std::max(1, parser.value("iterations").toInt());
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    const auto radii = BlurEngine::boxRadii(sigma);
+
+    QTextStream out(stdout);
+    out << "blur throughput, sigma " << sigma << " (box radii " << radii[0] << "/" << radii[1] << "/"
+        << radii[2] << "), " << iterations << " iterations, best kernels "
+        << BlurEngine::isaName(BlurEngine::bestIsa()) << "\n";
+
+    for (const QString &sizeText : parser.value("sizes").split(',', Qt::SkipEmptyParts)) {
+        const QSize size = parseSize(sizeText);
+        if (size.isEmpty()) {
+            QTextStream(stderr) << "bad size: " << sizeText << "\n";
+            return 1;
+        }
+        const QImage source = testImage(size);
+
+        QImage reference = source;
+        BlurEngine::gaussianBlur(reference, sigma, BlurEngine::Isa::Scalar, 1);
+
+        out << "\n" << size.width() << "x" << size.height() << "\n";
+        out << "kernels  threads  MP/s      identical\n";
+        for (BlurEngine::Isa isa : {BlurEngine::Isa::Scalar, BlurEngine::Isa::Sse2, BlurEngine::Isa::Avx2}) {
+            if (!BlurEngine::isSupported(isa)) continue;
+            for (int threadCount : {1, threads}) {
+                QImage image;
+                const double rate = megapixelsPerSecond(size, iterations, [&]() {
+                    image = source;
+                    BlurEngine::gaussianBlur(image, sigma, isa, threadCount);
+                });
+                out << QString("%1 %2 %3 %4\n")
+                           .arg(BlurEngine::isaName(isa), -8)
+                           .arg(threadCount, -8)
+                           .arg(rate, -9, 'f', 1)
+                           .arg(image == reference ? "yes" : "NO");
+                if (threadCount == threads) break;
+            }
+        }
+
+        QGraphicsScene scene;
+        QGraphicsPixmapItem *item = scene.addPixmap(QPixmap::fromImage(source));
+        auto *effect = new QGraphicsBlurEffect;
+        effect->setBlurRadius(3 * sigma);
+        effect->setBlurHints(QGraphicsBlurEffect::QualityHint);
+        item->setGraphicsEffect(effect);
+        QImage target(size, QImage::Format_ARGB32_Premultiplied);
+        const double effectRate = megapixelsPerSecond(size, iterations, [&]() {
+            target.fill(Qt::transparent);
+            QPainter painter(&target);
+            scene.render(&painter, QRectF(target.rect()), item->boundingRect());
+        });
+        out << QString("%1 %2 %3\n").arg("QGraphicsBlurEffect", -17).arg(effectRate, -9, 'f', 1);
+    }
+
+    return 0;
+}
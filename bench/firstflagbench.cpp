@@ -0,0 +1,204 @@
+// firstflagbench - Time to first flag, cold vs pre-connected, against a local TLS stand-in
+//
+// Starts an HTTPS server on localhost that serves one SVG and delays every
+// handshake by --setup-ms to stand in for the TCP + TLS round trips to a
+// real CDN. Each trial uses a fresh NetworkWorker (and so a fresh connection
+// pool):
+//
+//   cold    - the flag request is issued after --startup-ms, as before
+//   warmed  - preconnect() is issued at t0, the flag request after --startup-ms
+//
+// Both report the time from t0 to flagFetched(). --startup-ms models the
+// time main() spends building the window before the first flag is requested.
+// Failed trials are left out of the median and counted; the run exits with
+// an error if a mode has no successful trial.
+//
+// A throwaway certificate for localhost:
+//   openssl req -x509 -newkey rsa:2048 -nodes -days 30 -subj /CN=localhost \
+//       -addext subjectAltName=DNS:localhost -keyout key.pem -out cert.pem
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QSslCertificate>
+#include <QSslConfiguration>
+#include <QSslKey>
+#include <QSslSocket>
+#include <QTcpServer>
+#include <QTextStream>
+#include <QTimer>
+#include <QUrl>
+#include <algorithm>
+#include "networkservice.h"
+
+namespace {
+    const QByteArray FLAG_SVG =
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">"
+        "<circle cx=\"256\" cy=\"256\" r=\"256\" fill=\"#d80027\"/></svg>";
+
+    // TlsStandIn - Minimal keep-alive HTTPS/1.1 server answering every GET with FLAG_SVG
+    class TlsStandIn : public QTcpServer
+    {
+    public:
+        TlsStandIn(const QSslCertificate &certificate, const QSslKey &key, int setupDelayMs)
+            : m_certificate(certificate), m_key(key), m_setupDelayMs(setupDelayMs), m_connections(0) {}
+
+        int connections() const { return m_connections; }
+
+    protected:
+        void incomingConnection(qintptr socketDescriptor) override
+        {
+            auto *socket = new QSslSocket(this);
+            if (!socket->setSocketDescriptor(socketDescriptor)) {
+                delete socket;
+                return;
+            }
+            ++m_connections;
+
+            socket->setLocalCertificate(m_certificate);
+            socket->setPrivateKey(m_key);
+            connect(socket, &QSslSocket::disconnected, this, [this, socket]() {
+                m_buffers.remove(socket);
+                socket->deleteLater();
+            });
+            connect(socket, &QSslSocket::readyRead, this, [this, socket]() {
+                QByteArray &buffer = m_buffers[socket];
+                buffer += socket->readAll();
+                qsizetype end;
+                while ((end = buffer.indexOf("\r\n\r\n")) >= 0) {
+                    buffer.remove(0, end + 4);
+                    socket->write("HTTP/1.1 200 OK\r\n"
+                                  "Content-Type: image/svg+xml\r\n"
+                                  "Content-Length: " + QByteArray::number(FLAG_SVG.size()) + "\r\n"
+                                  "\r\n" + FLAG_SVG);
+                }
+            });
+
+            QTimer::singleShot(m_setupDelayMs, socket, [socket]() { socket->startServerEncryption(); });
+        }
+
+    private:
+        QSslCertificate m_certificate;
+        QSslKey m_key;
+        int m_setupDelayMs;
+        int m_connections;
+        QHash<QSslSocket *, QByteArray> m_buffers;  // partial request headers
+    };
+
+    // Milliseconds to the flag, or -1 if the fetch failed or was not a 200
+    double timeToFirstFlag(const QUrl &flagUrl, bool warm, int startupMs)
+    {
+        NetworkWorker worker;
+        QEventLoop loop;
+        QElapsedTimer timer;
+        double elapsedMs = -1;
+
+        QObject::connect(&worker, &NetworkWorker::flagFetched, &loop, [&](const QString &, int status) {
+            if (status == 200) {
+                elapsedMs = timer.nsecsElapsed() / 1e6;
+            } else {
+                QTextStream(stderr) << "fetch returned status " << status << "\n";
+            }
+            loop.quit();
+        });
+        QObject::connect(&worker, &NetworkWorker::flagFetchFailed, &loop, [&](const QString &, const QString &error) {
+            QTextStream(stderr) << "fetch failed: " << error << "\n";
+            loop.quit();
+        });
+
+        timer.start();
+        if (warm) {
+            worker.preconnect({flagUrl});
+        }
+        QTimer::singleShot(startupMs, &worker, [&]() {
+            worker.fetchFlag(flagUrl.toString(), QByteArray(), QByteArray(), true);
+        });
+        loop.exec();
+        return elapsedMs;
+    }
+
+    double median(QList<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values.at(values.size() / 2);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Time to first flag against a local TLS stand-in");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"cert", "PEM certificate for localhost.", "file"},
+        {"key", "PEM private key for the certificate.", "file"},
+        {"setup-ms", "Simulated connection setup latency.", "ms", "150"},
+        {"startup-ms", "Simulated window construction time before the first request.", "ms", "120"},
+        {"trials", "Trials per mode.", "count", "9"},
+    });
+    parser.process(app);
+
+    QFile certFile(parser.value("cert"));
+    QFile keyFile(parser.value("key"));
+    if (!QSslSocket::supportsSsl() || !certFile.open(QIODevice::ReadOnly) || !keyFile.open(QIODevice::ReadOnly)) {
+        QTextStream(stderr) << "TLS support and --cert/--key are required\n";
+        return 1;
+    }
+    const QSslCertificate certificate(&certFile, QSsl::Pem);
+    const QSslKey key(&keyFile, QSsl::Rsa, QSsl::Pem);
+
+    // Trust the stand-in for every connection this process makes
+    QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+    sslConfig.addCaCertificate(certificate);
+    QSslConfiguration::setDefaultConfiguration(sslConfig);
+
+    const int setupMs = parser.value("setup-ms").toInt();
+    const int startupMs = parser.value("startup-ms").toInt();
+    const int trials = std::max(1, parser.value("trials").toInt());
+
+    TlsStandIn server(certificate, key, setupMs);
+    if (!server.listen(QHostAddress::LocalHost)) {
+        QTextStream(stderr) << "cannot listen: " << server.errorString() << "\n";
+        return 1;
+    }
+    const QUrl flagUrl(QString("https://localhost:%1/flags/gb.svg").arg(server.serverPort()));
+
+    QTextStream out(stdout);
+    out << "time to first flag, setup " << setupMs << " ms, startup " << startupMs
+        << " ms, median of " << trials << "\n";
+
+    bool allModesMeasured = true;
+    for (bool warm : {false, true}) {
+        QList<double> samples;
+        int failures = 0;
+        const int connectionsBefore = server.connections();
+        for (int i = 0; i < trials; ++i) {
+            const double elapsedMs = timeToFirstFlag(flagUrl, warm, startupMs);
+            if (elapsedMs < 0) {
+                ++failures;
+            } else {
+                samples.append(elapsedMs);
+            }
+        }
+
+        out << (warm ? "warmed  " : "cold    ");
+        if (samples.isEmpty()) {
+            out << "no successful trial";
+            allModesMeasured = false;
+        } else {
+            out << QString::number(median(samples), 'f', 1) << " ms";
+        }
+        out << "  (" << server.connections() - connectionsBefore << " connections";
+        if (failures > 0) {
+            out << ", " << failures << " of " << trials << " failed";
+        }
+        out << ")\n";
+    }
+
+    return allModesMeasured ? 0 : 1;
+}
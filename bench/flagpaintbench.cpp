@@ -0,0 +1,101 @@
+// flagpaintbench - Paint cost of one flag: downscale-on-paint vs exact device-size blit
+//
+// "before" reproduces the old CrispCircleFlagWidget path: a pixmap rendered at
+// FLAG_SIZE * clamp(2 * dpr, 1, 4) drawn into the widget rect with
+// SmoothPixmapTransform. "after" draws the FlagRasterCache::rasterize()
+// result, which is already device-pixel sized, at its origin.
+//
+// Run with -platform offscreen on headless machines.
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QSvgRenderer>
+#include <QTextStream>
+#include <algorithm>
+#include "config.h"
+#include "flagrastercache.h"
+
+namespace {
+    constexpr int ITERATIONS = 20000;
+
+    // Stand-in for a circle flag with a few shapes and antialiased edges
+    const QByteArray FLAG_SVG =
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">"
+        "<mask id=\"m\"><circle cx=\"256\" cy=\"256\" r=\"256\" fill=\"#fff\"/></mask>"
+        "<g mask=\"url(#m)\">"
+        "<path fill=\"#eee\" d=\"M0 0h512v512H0z\"/>"
+        "<path fill=\"#d80027\" d=\"M0 0h512v167H0z\"/>"
+        "<path fill=\"#0052b4\" d=\"M0 345h512v167H0z\"/>"
+        "</g></svg>";
+
+    QPixmap renderOld(qreal dpr)
+    {
+        const int scale = static_cast<int>(std::clamp(dpr * 2,
+                                                      static_cast<qreal>(Config::MIN_RENDER_SCALE),
+                                                      static_cast<qreal>(Config::MAX_RENDER_SCALE)));
+        const QSize renderSize(Config::FLAG_SIZE * scale, Config::FLAG_SIZE * scale);
+
+        QPixmap pixmap(renderSize);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        QSvgRenderer(FLAG_SVG).render(&painter, QRectF(QPointF(0, 0), renderSize));
+        return pixmap;
+    }
+
+    template <typename PaintFn>
+    double nsPerPaint(qreal dpr, PaintFn paint)
+    {
+        // Simulates the widget backing store at the given device pixel ratio
+        QImage target(FlagRasterCache::devicePixelSize(QSize(Config::FLAG_SIZE, Config::FLAG_SIZE), dpr),
+                      QImage::Format_ARGB32_Premultiplied);
+        target.setDevicePixelRatio(dpr);
+
+        for (int i = 0; i < ITERATIONS / 10; ++i) {
+            QPainter painter(&target);
+            paint(painter);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            QPainter painter(&target);
+            paint(painter);
+        }
+        return static_cast<double>(timer.nsecsElapsed()) / ITERATIONS;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const QRect flagRect(0, 0, Config::FLAG_SIZE, Config::FLAG_SIZE);
+    out << "flag paint cost, " << ITERATIONS << " paints per case\n";
+    out << "dpr     before(ns)  after(ns)   speedup\n";
+
+    for (qreal dpr : {1.0, 1.25, 1.5, 2.0, 3.0}) {
+        const QPixmap oldPixmap = renderOld(dpr);
+        const QPixmap newPixmap = QPixmap::fromImage(
+            FlagRasterCache::rasterize(FLAG_SVG, flagRect.size(), dpr, 2));
+
+        const double before = nsPerPaint(dpr, [&](QPainter &painter) {
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+            painter.drawPixmap(flagRect, oldPixmap);
+        });
+        const double after = nsPerPaint(dpr, [&](QPainter &painter) {
+            painter.drawPixmap(0, 0, newPixmap);
+        });
+
+        out << qSetFieldWidth(8) << Qt::left << dpr
+            << qSetFieldWidth(12) << before << after
+            << qSetFieldWidth(0) << QString::number(before / after, 'f', 2) << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "blurengine.h"
+#include "blurkernels.h"
+#include <QList>
+#include <QPair>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+    bool cpuSupports(BlurEngine::Isa isa)
+    {
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+        int info[4];
+        __cpuid(info, 1);
+        if (isa == BlurEngine::Isa::Sse2) {
+            return info[3] & (1 << 26);
+        }
+        // AVX2 also needs the OS to save the YMM registers
+        const bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return osSavesYmm && (info[1] & (1 << 5));
+#elif defined(Q_PROCESSOR_X86)
+        return isa == BlurEngine::Isa::Sse2 ? __builtin_cpu_supports("sse2") : __builtin_cpu_supports("avx2");
+#else
+        Q_UNUSED(isa);
+        return false;
+#endif
+    }
+
+    const BlurKernels::Table *kernelsFor(BlurEngine::Isa isa)
+    {
+        switch (isa) {
+        case BlurEngine::Isa::Avx2: return BlurKernels::avx2();
+        case BlurEngine::Isa::Sse2: return BlurKernels::sse2();
+        case BlurEngine::Isa::Scalar: break;
+        }
+        return BlurKernels::scalar();
+    }
+
+    bool isBlurFormat(QImage::Format format)
+    {
+        return format == QImage::Format_ARGB32_Premultiplied || format == QImage::Format_RGB32;
+    }
+
+    // Splits [0, count) into at most `bands` ranges whose starts are multiples of alignment
+    void runBands(int count, int alignment, int bands, const std::function<void(int, int)> &run)
+    {
+        const int perBand = (count + bands - 1) / bands;
+        const int step = (perBand + alignment - 1) / alignment * alignment;
+        if (bands <= 1 || step >= count) {
+            run(0, count);
+            return;
+        }
+
+        QList<QPair<int, int>> ranges;
+        for (int begin = 0; begin < count; begin += step) {
+            ranges.append({begin, std::min(count, begin + step)});
+        }
+        QtConcurrent::blockingMap(ranges, [&run](const QPair<int, int> &range) {
+            run(range.first, range.second);
+        });
+    }
+}
+
+bool BlurEngine::isSupported(Isa isa)
+{
+    if (isa == Isa::Scalar) return true;
+    return kernelsFor(isa) && cpuSupports(isa);
+}
+
+BlurEngine::Isa BlurEngine::bestIsa()
+{
+    static const Isa best = isSupported(Isa::Avx2) ? Isa::Avx2
+                          : isSupported(Isa::Sse2) ? Isa::Sse2
+                                                   : Isa::Scalar;
+    return best;
+}
+
+const char *BlurEngine::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Avx2: return "avx2";
+    case Isa::Sse2: return "sse2";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
+
+std::array<int, 3> BlurEngine::boxRadii(qreal sigma)
+{
+    // Box widths wl and wl + 2 whose summed variances match sigma^2 (three passes)
+    constexpr int passes = 3;
+    const qreal variance = sigma * sigma;
+    int wl = int(std::floor(std::sqrt(12 * variance / passes + 1)));
+    if (wl % 2 == 0) --wl;
+    wl = std::max(1, wl);
+    const int m = qRound((12 * variance - passes * wl * wl - 4 * passes * wl - 3 * passes) / (-4.0 * wl - 4));
+
+    std::array<int, 3> radii;
+    for (int i = 0; i < passes; ++i) {
+        const int width = i < m ? wl : wl + 2;
+        radii[i] = std::clamp((width - 1) / 2, 0, MAX_BOX_RADIUS);
+    }
+    return radii;
+}
+
+void BlurEngine::gaussianBlur(QImage &image, qreal sigma)
+{
+    gaussianBlur(image, sigma, bestIsa(), QThreadPool::globalInstance()->maxThreadCount());
+}
+
+void BlurEngine::gaussianBlur(QImage &image, qreal sigma, Isa isa, int maxThreads)
+{
+    if (image.isNull() || sigma <= 0) return;
+    if (!isBlurFormat(image.format())) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    }
+    if (!isSupported(isa)) {
+        isa = bestIsa();
+    }
+
+    const BlurKernels::Table *kernels = kernelsFor(isa);
+    const std::array<int, 3> radii = boxRadii(sigma);
+    const int width = image.width();
+    const int height = image.height();
+    uchar *bits = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int bands = qint64(width) * height >= PARALLEL_MIN_PIXELS ? std::max(1, maxThreads) : 1;
+
+    // Every row must be done before any column starts; each band gets its own scratch
+    runBands(height, kernels->rowsPerStep, bands, [&](int begin, int end) {
+        std::vector<quint32> scratch(size_t(2) * kernels->rowsPerStep * width);
+        kernels->horizontal(bits, bytesPerLine, width, begin, end, radii.data(), int(radii.size()), scratch.data());
+    });
+    runBands(width, kernels->columnsPerStrip, bands, [&](int begin, int end) {
+        std::vector<quint32> scratch(size_t(2) * kernels->columnsPerStrip * height);
+        kernels->vertical(bits, bytesPerLine, height, begin, end, radii.data(), int(radii.size()), scratch.data());
+    });
+}
+
+void BlurEngine::blurRect(QImage &image, const QRect &rect, qreal sigma)
+{
+    const QRect area = rect.intersected(image.rect());
+    if (area.isEmpty() || sigma <= 0) return;
+    if (!isBlurFormat(image.format())) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QImage patch = image.copy(area);
+    gaussianBlur(patch, sigma);
+    for (int y = 0; y < area.height(); ++y) {
+        std::memcpy(image.scanLine(area.top() + y) + area.left() * sizeof(quint32),
+                    patch.constScanLine(y), area.width() * sizeof(quint32));
+    }
+}
+
+QImage BlurEngine::blurred(const QImage &image, qreal sigma)
+{
+    QImage result = isBlurFormat(image.format()) ? image.copy()
+                                                 : image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    gaussianBlur(result, sigma);
+    return result;
+}
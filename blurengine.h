@@ -0,0 +1,45 @@
+#ifndef BLURENGINE_H
+#define BLURENGINE_H
+
+#include <QImage>
+#include <QRect>
+#include <array>
+
+// BlurEngine - Separable Gaussian blur for premultiplied ARGB32 images
+//
+// A Gaussian of the requested sigma is approximated by three box passes per
+// axis, each a running sum, so the cost per pixel does not depend on the
+// radius. The passes run on the widest kernel set the CPU supports (AVX2,
+// SSE2 or plain C++, see BlurKernels); all of them produce identical
+// pixels. Images of PARALLEL_MIN_PIXELS or more are split into row bands
+// for the horizontal passes and column bands for the vertical ones, which
+// run on QThreadPool::globalInstance().
+//
+// Used for the cached drop shadows, the frosted backdrop behind the
+// language dropdown and for redacting parts of an image.
+class BlurEngine
+{
+public:
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    static constexpr int PARALLEL_MIN_PIXELS = 256 * 256;
+    static constexpr int MAX_BOX_RADIUS = 1024;
+
+    static bool isSupported(Isa isa);
+    static Isa bestIsa();
+    static const char *isaName(Isa isa);
+
+    // Box radii of the three passes that approximate sigma, in device pixels
+    static std::array<int, 3> boxRadii(qreal sigma);
+
+    // Blurs in place; images that are not ARGB32_Premultiplied or RGB32 are converted first
+    static void gaussianBlur(QImage &image, qreal sigma);
+    static void gaussianBlur(QImage &image, qreal sigma, Isa isa, int maxThreads);
+
+    // Blurs only rect; edges repeat inside it, so nothing outside bleeds in or out
+    static void blurRect(QImage &image, const QRect &rect, qreal sigma);
+
+    static QImage blurred(const QImage &image, qreal sigma);
+};
+
+#endif // BLURENGINE_H
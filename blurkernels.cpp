@@ -0,0 +1,81 @@
+#include "blurkernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // One box pass over a contiguous line; output pixels are dstStride bytes apart
+    void boxLine(const uint32_t *src, unsigned char *dst, std::ptrdiff_t dstStride, int length, int radius)
+    {
+        const float scale = 1.0f / float(2 * radius + 1);
+        const int last = length - 1;
+        int sum[4] = {0, 0, 0, 0};
+        auto accumulate = [&sum](uint32_t pixel, int weight) {
+            for (int c = 0; c < 4; ++c) {
+                sum[c] += weight * int((pixel >> (8 * c)) & 0xff);
+            }
+        };
+
+        accumulate(src[0], radius + 1);
+        for (int k = 1; k <= radius; ++k) {
+            accumulate(src[std::min(k, last)], 1);
+        }
+        for (int i = 0; i < length; ++i) {
+            uint32_t out = 0;
+            for (int c = 0; c < 4; ++c) {
+                out |= uint32_t(std::lrint(float(sum[c]) * scale)) << (8 * c);
+            }
+            std::memcpy(dst + i * dstStride, &out, sizeof(out));
+            accumulate(src[std::min(i + radius + 1, last)], 1);
+            accumulate(src[std::max(i - radius, 0)], -1);
+        }
+    }
+
+    // Ping-pongs between the two scratch lines; the last pass writes to the image
+    void runPasses(uint32_t *lineA, uint32_t *lineB, unsigned char *dst, std::ptrdiff_t dstStride,
+                   int length, const int *radii, int passes)
+    {
+        for (int pass = 0; pass < passes; ++pass) {
+            const uint32_t *src = pass % 2 ? lineB : lineA;
+            if (pass == passes - 1) {
+                boxLine(src, dst, dstStride, length, radii[pass]);
+            } else {
+                uint32_t *next = pass % 2 ? lineA : lineB;
+                boxLine(src, reinterpret_cast<unsigned char *>(next), sizeof(uint32_t), length, radii[pass]);
+            }
+        }
+    }
+
+    void horizontal(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                    int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        uint32_t *lineA = scratch;
+        uint32_t *lineB = scratch + length;
+        for (int y = begin; y < end; ++y) {
+            unsigned char *row = bits + y * bytesPerLine;
+            std::memcpy(lineA, row, length * sizeof(uint32_t));
+            runPasses(lineA, lineB, row, sizeof(uint32_t), length, radii, passes);
+        }
+    }
+
+    void vertical(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                  int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        uint32_t *lineA = scratch;
+        uint32_t *lineB = scratch + length;
+        for (int x = begin; x < end; ++x) {
+            unsigned char *column = bits + x * sizeof(uint32_t);
+            for (int y = 0; y < length; ++y) {
+                std::memcpy(lineA + y, column + y * bytesPerLine, sizeof(uint32_t));
+            }
+            runPasses(lineA, lineB, column, bytesPerLine, length, radii, passes);
+        }
+    }
+
+    const BlurKernels::Table SCALAR = {1, 1, horizontal, vertical};
+}
+
+const BlurKernels::Table *BlurKernels::scalar()
+{
+    return &SCALAR;
+}
@@ -0,0 +1,36 @@
+#ifndef BLURKERNELS_H
+#define BLURKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// BlurKernels - Per-instruction-set box blur passes behind BlurEngine
+//
+// Each table lives in its own translation unit, compiled with that
+// instruction set enabled, and is only called once BlurEngine has checked
+// the CPU. Those files include nothing but this header and the intrinsics
+// headers: an inline Qt or std template instantiated there could be merged
+// with the baseline copy by the linker and run on a CPU without AVX2.
+//
+// Pixels are 32-bit premultiplied ARGB. A pass call runs every box radius
+// in turn over rows [begin, end) (horizontal) or columns [begin, end)
+// (vertical), each `length` pixels long, with edge pixels repeated. Every
+// table rounds the same way, so all of them produce identical output.
+namespace BlurKernels {
+    using Pass = void (*)(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                          int begin, int end, const int *radii, int passes, uint32_t *scratch);
+
+    struct Table {
+        int rowsPerStep;        // horizontal scratch is 2 * length * rowsPerStep pixels
+        int columnsPerStrip;    // vertical scratch is 2 * length * columnsPerStrip pixels
+        Pass horizontal;
+        Pass vertical;
+    };
+
+    // Null when the instruction set is not available for this target architecture
+    const Table *scalar();
+    const Table *sse2();
+    const Table *avx2();
+}
+
+#endif // BLURKERNELS_H
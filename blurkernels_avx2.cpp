@@ -0,0 +1,149 @@
+#include "blurkernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include <cstring>
+
+namespace {
+    inline int clampIndex(int i, int last)
+    {
+        return i < 0 ? 0 : (i > last ? last : i);
+    }
+
+    inline __m256i average(__m256i sum, __m256 scale)
+    {
+        return _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(sum), scale));
+    }
+
+    // Two rows per step: src holds the rows interleaved pixel by pixel, so one
+    // register carries the same column of both. Outputs go to dstA and dstB,
+    // each dstStride bytes per pixel.
+    void boxLinePair(const uint32_t *src, unsigned char *dstA, unsigned char *dstB,
+                     std::ptrdiff_t dstStride, int length, int radius)
+    {
+        const __m256 scale = _mm256_set1_ps(1.0f / float(2 * radius + 1));
+        const int last = length - 1;
+        auto load = [src](int i) {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + 2 * i)));
+        };
+
+        __m256i sum = _mm256_mullo_epi32(load(0), _mm256_set1_epi32(radius + 1));
+        for (int k = 1; k <= radius; ++k) {
+            sum = _mm256_add_epi32(sum, load(clampIndex(k, last)));
+        }
+        for (int i = 0; i < length; ++i) {
+            __m256i out = average(sum, scale);
+            out = _mm256_packs_epi32(out, out);
+            out = _mm256_packus_epi16(out, out);
+            const int a = _mm_cvtsi128_si32(_mm256_castsi256_si128(out));
+            const int b = _mm_cvtsi128_si32(_mm256_extracti128_si256(out, 1));
+            std::memcpy(dstA + i * dstStride, &a, sizeof(a));
+            std::memcpy(dstB + i * dstStride, &b, sizeof(b));
+
+            sum = _mm256_add_epi32(sum, load(clampIndex(i + radius + 1, last)));
+            sum = _mm256_sub_epi32(sum, load(clampIndex(i - radius, last)));
+        }
+    }
+
+    // Eight adjacent columns per step: src rows are 8 contiguous pixels, dst rows dstStride apart
+    void boxStrip(const uint32_t *src, unsigned char *dst, std::ptrdiff_t dstStride, int length, int radius)
+    {
+        const __m256 scale = _mm256_set1_ps(1.0f / float(2 * radius + 1));
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        const int last = length - 1;
+        __m256i sum[4];
+
+        // lanes[p] holds pixels 2p and 2p + 1 of the row
+        auto load = [src](int row, __m256i lanes[4]) {
+            const uint32_t *pixels = src + 8 * row;
+            for (int p = 0; p < 4; ++p) {
+                lanes[p] = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pixels + 2 * p)));
+            }
+        };
+
+        __m256i lanes[4];
+        load(0, lanes);
+        const __m256i weight = _mm256_set1_epi32(radius + 1);
+        for (int p = 0; p < 4; ++p) sum[p] = _mm256_mullo_epi32(lanes[p], weight);
+        for (int k = 1; k <= radius; ++k) {
+            load(clampIndex(k, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm256_add_epi32(sum[p], lanes[p]);
+        }
+        for (int i = 0; i < length; ++i) {
+            // The packs work per 128-bit half; the permute puts the pixels back in order
+            const __m256i low = _mm256_packs_epi32(average(sum[0], scale), average(sum[1], scale));
+            const __m256i high = _mm256_packs_epi32(average(sum[2], scale), average(sum[3], scale));
+            const __m256i out = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(low, high), order);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * dstStride), out);
+
+            load(clampIndex(i + radius + 1, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm256_add_epi32(sum[p], lanes[p]);
+            load(clampIndex(i - radius, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm256_sub_epi32(sum[p], lanes[p]);
+        }
+    }
+
+    void horizontal(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                    int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        uint32_t *pair[2] = {scratch, scratch + 2 * length};
+        for (int y = begin; y < end; y += 2) {
+            // An odd last row is paired with itself and written twice
+            unsigned char *rowA = bits + y * bytesPerLine;
+            unsigned char *rowB = y + 1 < end ? rowA + bytesPerLine : rowA;
+            for (int x = 0; x < length; ++x) {
+                std::memcpy(pair[0] + 2 * x, rowA + x * sizeof(uint32_t), sizeof(uint32_t));
+                std::memcpy(pair[0] + 2 * x + 1, rowB + x * sizeof(uint32_t), sizeof(uint32_t));
+            }
+            for (int pass = 0; pass < passes; ++pass) {
+                const uint32_t *src = pair[pass % 2];
+                if (pass == passes - 1) {
+                    boxLinePair(src, rowA, rowB, sizeof(uint32_t), length, radii[pass]);
+                } else {
+                    unsigned char *next = reinterpret_cast<unsigned char *>(pair[(pass + 1) % 2]);
+                    boxLinePair(src, next, next + sizeof(uint32_t), 2 * sizeof(uint32_t), length, radii[pass]);
+                }
+            }
+        }
+    }
+
+    void vertical(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                  int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        constexpr int STRIP = 8;
+        uint32_t *strip[2] = {scratch, scratch + STRIP * length};
+        int x = begin;
+        for (; x + STRIP <= end; x += STRIP) {
+            unsigned char *columns = bits + x * sizeof(uint32_t);
+            for (int y = 0; y < length; ++y) {
+                std::memcpy(strip[0] + STRIP * y, columns + y * bytesPerLine, STRIP * sizeof(uint32_t));
+            }
+            for (int pass = 0; pass < passes; ++pass) {
+                const bool lastPass = pass == passes - 1;
+                unsigned char *dst = lastPass ? columns : reinterpret_cast<unsigned char *>(strip[(pass + 1) % 2]);
+                boxStrip(strip[pass % 2], dst, lastPass ? bytesPerLine : STRIP * sizeof(uint32_t),
+                         length, radii[pass]);
+            }
+        }
+        if (x < end) {
+            // Every AVX2 CPU has SSE2; its strips are narrower, so the scratch fits
+            BlurKernels::sse2()->vertical(bits, bytesPerLine, length, x, end, radii, passes, scratch);
+        }
+    }
+
+    const BlurKernels::Table AVX2 = {2, 8, horizontal, vertical};
+}
+
+const BlurKernels::Table *BlurKernels::avx2()
+{
+    return &AVX2;
+}
+
+#else
+
+const BlurKernels::Table *BlurKernels::avx2()
+{
+    return nullptr;
+}
+
+#endif
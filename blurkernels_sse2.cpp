@@ -0,0 +1,147 @@
+#include "blurkernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include <cstring>
+
+namespace {
+    inline int clampIndex(int i, int last)
+    {
+        return i < 0 ? 0 : (i > last ? last : i);
+    }
+
+    // Four unsigned bytes -> four 32-bit lanes
+    inline __m128i widen(__m128i bytes)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+    }
+
+    inline __m128i loadPixel(const uint32_t *pixel)
+    {
+        return widen(_mm_cvtsi32_si128(int(*pixel)));
+    }
+
+    // SSE2 has no 32-bit multiply; the lanes hold bytes, so a 16-bit madd is exact
+    inline __m128i times(__m128i lanes, int weight)
+    {
+        return _mm_madd_epi16(lanes, _mm_set1_epi32(weight));
+    }
+
+    inline __m128i average(__m128i sum, __m128 scale)
+    {
+        return _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+    }
+
+    // One pixel per step; output pixels are dstStride bytes apart
+    void boxLine(const uint32_t *src, unsigned char *dst, std::ptrdiff_t dstStride, int length, int radius)
+    {
+        const __m128 scale = _mm_set1_ps(1.0f / float(2 * radius + 1));
+        const int last = length - 1;
+
+        __m128i sum = times(loadPixel(src), radius + 1);
+        for (int k = 1; k <= radius; ++k) {
+            sum = _mm_add_epi32(sum, loadPixel(src + clampIndex(k, last)));
+        }
+        for (int i = 0; i < length; ++i) {
+            __m128i out = average(sum, scale);
+            out = _mm_packus_epi16(_mm_packs_epi32(out, out), out);
+            const int packed = _mm_cvtsi128_si32(out);
+            std::memcpy(dst + i * dstStride, &packed, sizeof(packed));
+
+            sum = _mm_add_epi32(sum, loadPixel(src + clampIndex(i + radius + 1, last)));
+            sum = _mm_sub_epi32(sum, loadPixel(src + clampIndex(i - radius, last)));
+        }
+    }
+
+    // Four adjacent columns per step: src rows are 4 contiguous pixels, dst rows dstStride apart
+    void boxStrip(const uint32_t *src, unsigned char *dst, std::ptrdiff_t dstStride, int length, int radius)
+    {
+        const __m128 scale = _mm_set1_ps(1.0f / float(2 * radius + 1));
+        const __m128i zero = _mm_setzero_si128();
+        const int last = length - 1;
+        __m128i sum[4];
+
+        auto load = [&](int row, __m128i lanes[4]) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 4 * row));
+            const __m128i low = _mm_unpacklo_epi8(pixels, zero);
+            const __m128i high = _mm_unpackhi_epi8(pixels, zero);
+            lanes[0] = _mm_unpacklo_epi16(low, zero);
+            lanes[1] = _mm_unpackhi_epi16(low, zero);
+            lanes[2] = _mm_unpacklo_epi16(high, zero);
+            lanes[3] = _mm_unpackhi_epi16(high, zero);
+        };
+
+        __m128i lanes[4];
+        load(0, lanes);
+        for (int p = 0; p < 4; ++p) sum[p] = times(lanes[p], radius + 1);
+        for (int k = 1; k <= radius; ++k) {
+            load(clampIndex(k, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm_add_epi32(sum[p], lanes[p]);
+        }
+        for (int i = 0; i < length; ++i) {
+            const __m128i low = _mm_packs_epi32(average(sum[0], scale), average(sum[1], scale));
+            const __m128i high = _mm_packs_epi32(average(sum[2], scale), average(sum[3], scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * dstStride), _mm_packus_epi16(low, high));
+
+            load(clampIndex(i + radius + 1, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm_add_epi32(sum[p], lanes[p]);
+            load(clampIndex(i - radius, last), lanes);
+            for (int p = 0; p < 4; ++p) sum[p] = _mm_sub_epi32(sum[p], lanes[p]);
+        }
+    }
+
+    void horizontal(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                    int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        uint32_t *line[2] = {scratch, scratch + length};
+        for (int y = begin; y < end; ++y) {
+            unsigned char *row = bits + y * bytesPerLine;
+            std::memcpy(line[0], row, length * sizeof(uint32_t));
+            for (int pass = 0; pass < passes; ++pass) {
+                const bool lastPass = pass == passes - 1;
+                unsigned char *dst = lastPass ? row : reinterpret_cast<unsigned char *>(line[(pass + 1) % 2]);
+                boxLine(line[pass % 2], dst, sizeof(uint32_t), length, radii[pass]);
+            }
+        }
+    }
+
+    void vertical(unsigned char *bits, std::ptrdiff_t bytesPerLine, int length,
+                  int begin, int end, const int *radii, int passes, uint32_t *scratch)
+    {
+        constexpr int STRIP = 4;
+        uint32_t *strip[2] = {scratch, scratch + STRIP * length};
+        int x = begin;
+        for (; x + STRIP <= end; x += STRIP) {
+            unsigned char *columns = bits + x * sizeof(uint32_t);
+            for (int y = 0; y < length; ++y) {
+                std::memcpy(strip[0] + STRIP * y, columns + y * bytesPerLine, STRIP * sizeof(uint32_t));
+            }
+            for (int pass = 0; pass < passes; ++pass) {
+                const bool lastPass = pass == passes - 1;
+                unsigned char *dst = lastPass ? columns : reinterpret_cast<unsigned char *>(strip[(pass + 1) % 2]);
+                boxStrip(strip[pass % 2], dst, lastPass ? bytesPerLine : STRIP * sizeof(uint32_t),
+                         length, radii[pass]);
+            }
+        }
+        if (x < end) {
+            BlurKernels::scalar()->vertical(bits, bytesPerLine, length, x, end, radii, passes, scratch);
+        }
+    }
+
+    const BlurKernels::Table SSE2 = {1, 4, horizontal, vertical};
+}
+
+const BlurKernels::Table *BlurKernels::sse2()
+{
+    return &SSE2;
+}
+
+#else
+
+const BlurKernels::Table *BlurKernels::sse2()
+{
+    return nullptr;
+}
+
+#endif
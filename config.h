@@ -12,27 +12,48 @@ namespace Config {
     constexpr int DROPDOWN_WIDTH = 280;
     constexpr int DROPDOWN_MAX_HEIGHT = 220;
     constexpr int DROPDOWN_ITEM_HEIGHT = 50;
+    constexpr int DROPDOWN_SEARCH_HEIGHT = 40;
+    constexpr int DROPDOWN_SEARCH_SPACING = 6;
     constexpr int FLAG_SIZE = 28;
     constexpr int BUTTON_SPACING = 10;
     constexpr int CARD_RADIUS = 30;
     constexpr int DROPDOWN_RADIUS = 16;
+    constexpr int DROPDOWN_BACKDROP_BLUR = 10;   // Gaussian sigma, logical pixels
+    constexpr int DROPDOWN_PREWARM_DELAY_MS = 200;  // after the button is first shown
     
     // Network Constants
     constexpr int NETWORK_TIMEOUT_MS = 5000;
     constexpr int GEOLOCATION_DELAY_MS = 500;
+    constexpr int FLAG_FAILURE_TTL_MS = 60000;
+    constexpr int FLAG_FETCH_CONCURRENCY = 4;
     
     // Rendering Constants
     constexpr int MAX_RENDER_SCALE = 4;
     constexpr int MIN_RENDER_SCALE = 1;
+    constexpr int FLAG_RASTER_CACHE_KB = 8 * 1024;
+    constexpr int SVG_RASTER_CACHE_KB = 16 * 1024;
+    constexpr int PAINT_CACHE_KB = 4 * 1024;
+    constexpr int ARROW_ROTATION_FRAMES = 60;   // 6 degree steps over a full turn
+    constexpr int ARROW_ANIMATION_MS = 250;
+
+    // Quality tiers (see RenderQuality)
+    constexpr int QUALITY_PROBE_SAMPLES = 12;
+    constexpr int QUALITY_PROBE_INTERVAL_MS = 150;
+    constexpr int QUALITY_REDUCED_FRAME_MS = 16;
+    constexpr int QUALITY_MINIMAL_FRAME_MS = 40;
     
     // Default Language
     const QString DEFAULT_LANGUAGE = "EN";
     const QString DEFAULT_COUNTRY = "gb";
     
-    // Resource Paths
-    const QString STYLES_QRC = ":/styles/";
-    const QString FLAGS_QRC = ":/flags/";
-    const QString TRANSLATIONS_QRC = ":/translations/";
+    // Asset pack (built from resources.qrc) and the names inside it
+    const QString ASSET_PACK_FILE = "pandablur.pack";
+    const QString ASSET_SCHEME = "asset:";
+    const QString STYLES_ASSETS = "styles/";
+    const QString FLAGS_ASSETS = "flags/";
+    const QString TRANSLATIONS_ASSETS = "translations/";
+    const QString FLAGS_REMOTE_URL = "https://hatscripts.github.io/circle-flags/flags/";
+    const QString GEOLOCATION_URL = "https://ipapi.co/json/";
 }
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "dropshadow.h"
+#include "blurengine.h"
+#include "flagrastercache.h"
+#include "renderquality.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+
+namespace {
+    QString patchKey(const QSize &maskSize, const ShadowSpec &spec, qreal devicePixelRatio)
+    {
+        return QString("%1x%2/%3/%4/%5@%6").arg(maskSize.width()).arg(maskSize.height())
+            .arg(spec.cornerRadius).arg(spec.blurRadius).arg(spec.color.rgba())
+            .arg(qRound(devicePixelRatio * 100));
+    }
+}
+
+// ShadowCache - Owned by the application object so no pixmap outlives QApplication
+ShadowCache& ShadowCache::instance()
+{
+    static ShadowCache *instance = new ShadowCache(QCoreApplication::instance());
+    return *instance;
+}
+
+ShadowCache::ShadowCache(QObject *parent)
+    : QObject(parent)
+{
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_patches.clear();
+    });
+}
+
+QImage ShadowCache::renderShadow(const QSize &maskSize, const ShadowSpec &spec, qreal devicePixelRatio)
+{
+    const int pad = spec.blurRadius;
+    const QSize logicalSize = maskSize + QSize(2 * pad, 2 * pad);
+    const QSize deviceSize = FlagRasterCache::devicePixelSize(logicalSize, devicePixelRatio);
+
+    QImage shadow(deviceSize, QImage::Format_ARGB32_Premultiplied);
+    shadow.fill(Qt::transparent);
+    {
+        QPainter painter(&shadow);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.scale(devicePixelRatio, devicePixelRatio);
+        QPainterPath path;
+        path.addRoundedRect(QRectF(QPointF(pad, pad), maskSize), spec.cornerRadius, spec.cornerRadius);
+        painter.fillPath(path, spec.color);
+    }
+    // Support of ~3 sigma each side, so the blur fades out within the blurRadius padding
+    BlurEngine::gaussianBlur(shadow, spec.blurRadius * devicePixelRatio / 3.0);
+    shadow.setDevicePixelRatio(devicePixelRatio);
+    return shadow;
+}
+
+ShadowCache::NinePatch ShadowCache::ninePatch(const QSize &shapeSize, const ShadowSpec &spec, qreal devicePixelRatio)
+{
+    // Shortest extent whose middle row/column is untouched by both the corners and the blur
+    const int stretchable = 2 * (spec.cornerRadius + spec.blurRadius) + 1;
+    const QSize maskSize(shapeSize.width() >= stretchable ? stretchable : shapeSize.width(),
+                         shapeSize.height() >= stretchable ? stretchable : shapeSize.height());
+
+    const QString key = patchKey(maskSize, spec, devicePixelRatio);
+    auto it = m_patches.constFind(key);
+    if (it != m_patches.constEnd()) return it.value();
+
+    NinePatch patch;
+    patch.pixmap = QPixmap::fromImage(renderShadow(maskSize, spec, devicePixelRatio));
+
+    const QSize total = maskSize + QSize(2 * spec.blurRadius, 2 * spec.blurRadius);
+    const int edge = spec.cornerRadius + 2 * spec.blurRadius;
+    const bool stretchX = maskSize.width() == stretchable;
+    const bool stretchY = maskSize.height() == stretchable;
+    const int left = stretchX ? edge : total.width() / 2;
+    const int top = stretchY ? edge : total.height() / 2;
+    patch.margins = QMargins(left, top, stretchX ? edge : total.width() - left,
+                             stretchY ? edge : total.height() - top);
+
+    m_patches.insert(key, patch);
+    return patch;
+}
+
+void ShadowCache::draw(QPainter *painter, const QRect &target, const NinePatch &patch, bool drawCenter)
+{
+    const qreal dpr = patch.pixmap.devicePixelRatio();
+    const QSize source = patch.pixmap.size();
+    const QMargins &m = patch.margins;
+
+    // Column and row boundaries in logical target coordinates and device source pixels
+    const int tx[4] = {target.left(), target.left() + m.left(), target.right() + 1 - m.right(), target.right() + 1};
+    const int ty[4] = {target.top(), target.top() + m.top(), target.bottom() + 1 - m.bottom(), target.bottom() + 1};
+    const int sx[4] = {0, qRound(m.left() * dpr), source.width() - qRound(m.right() * dpr), source.width()};
+    const int sy[4] = {0, qRound(m.top() * dpr), source.height() - qRound(m.bottom() * dpr), source.height()};
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            if (row == 1 && column == 1 && !drawCenter) continue;
+
+            const QRect targetCell(QPoint(tx[column], ty[row]), QPoint(tx[column + 1] - 1, ty[row + 1] - 1));
+            const QRect sourceCell(QPoint(sx[column], sy[row]), QPoint(sx[column + 1] - 1, sy[row + 1] - 1));
+            if (targetCell.isEmpty() || sourceCell.isEmpty()) continue;
+            painter->drawPixmap(targetCell, patch.pixmap, sourceCell);
+        }
+    }
+}
+
+// DropShadowWidget - Sibling beneath the target; repaints are blits, never blurs
+DropShadowWidget *DropShadowWidget::attach(QWidget *target, const ShadowSpec &spec)
+{
+    return target ? new DropShadowWidget(target, spec) : nullptr;
+}
+
+DropShadowWidget::DropShadowWidget(QWidget *target, const ShadowSpec &spec)
+    : QWidget(target->parentWidget())
+    , m_target(target)
+    , m_spec(spec)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setAttribute(Qt::WA_NoSystemBackground, true);
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+    setFocusPolicy(Qt::NoFocus);
+
+    target->installEventFilter(this);
+    connect(target, &QObject::destroyed, this, &QObject::deleteLater);
+    connect(&RenderQuality::instance(), &RenderQuality::tierChanged, this, [this]() {
+        syncGeometry();
+        update();
+    });
+
+    syncGeometry();
+}
+
+void DropShadowWidget::syncGeometry()
+{
+    if (!m_target) return;
+
+    // Follows the target when a layout reparents it; never shown as a top-level window
+    if (parentWidget() != m_target->parentWidget()) {
+        setParent(m_target->parentWidget());
+    }
+    if (!parentWidget() || !RenderQuality::instance().shadowsEnabled()) {
+        hide();
+        return;
+    }
+
+    const ShadowSpec spec = effectiveSpec();
+    const int extent = spec.blurRadius;
+    setGeometry(m_target->geometry().translated(spec.offset).adjusted(-extent, -extent, extent, extent));
+    stackUnder(m_target);
+    setVisible(!m_target->isHidden());
+}
+
+ShadowSpec DropShadowWidget::effectiveSpec() const
+{
+    ShadowSpec spec = m_spec;
+    spec.blurRadius = RenderQuality::instance().shadowBlurRadius(m_spec.blurRadius);
+    return spec;
+}
+
+bool DropShadowWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_target) {
+        switch (event->type()) {
+        case QEvent::Move:
+        case QEvent::Resize:
+        case QEvent::ParentChange:
+        case QEvent::Show:
+        case QEvent::Hide:
+            syncGeometry();
+            break;
+        default:
+            break;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void DropShadowWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    if (!m_target) return;
+
+    const ShadowSpec spec = effectiveSpec();
+    const ShadowCache::NinePatch patch =
+        ShadowCache::instance().ninePatch(m_target->size(), spec, devicePixelRatioF());
+
+    // The opaque target hides the middle cell unless the offset pushes it out from under it
+    const QRect targetArea = m_target->geometry().translated(-pos())
+                                 .adjusted(spec.cornerRadius, spec.cornerRadius,
+                                           -spec.cornerRadius, -spec.cornerRadius);
+    const QRect centerCell = rect().adjusted(patch.margins.left(), patch.margins.top(),
+                                             -patch.margins.right(), -patch.margins.bottom());
+
+    QPainter painter(this);
+    ShadowCache::draw(&painter, rect(), patch, !targetArea.contains(centerCell));
+}
@@ -0,0 +1,85 @@
+#ifndef DROPSHADOW_H
+#define DROPSHADOW_H
+
+#include <QObject>
+#include <QWidget>
+#include <QHash>
+#include <QColor>
+#include <QMargins>
+#include <QPixmap>
+#include <QPointer>
+
+// ShadowSpec - Everything that determines what a cached shadow looks like
+struct ShadowSpec
+{
+    int cornerRadius = 0;
+    int blurRadius = 0;
+    QColor color;
+    QPoint offset;
+};
+
+// ShadowCache - Blurred rounded-rect masks stored as nine-patches
+//
+// A shadow is blurred once per (corner radius, blur radius, colour, DPR) at
+// the smallest size that still has a flat middle row and column, so the
+// same pixmap stretches to any card size. A dimension too short for a flat
+// middle (a pill-shaped button's height, say) is blurred at its exact size
+// and becomes part of the key. Owned by the application object and emptied
+// on aboutToQuit.
+class ShadowCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct NinePatch {
+        QPixmap pixmap;
+        QMargins margins;   // logical pixels; zero-width middles are exact-size dimensions
+    };
+
+    static ShadowCache& instance();
+
+    // Patch for a shape of the given logical size; it covers size grown by blurRadius on every side
+    NinePatch ninePatch(const QSize &shapeSize, const ShadowSpec &spec, qreal devicePixelRatio);
+
+    // Draws the patch over target; the middle cell is skipped when the caller covers it anyway
+    static void draw(QPainter *painter, const QRect &target, const NinePatch &patch, bool drawCenter);
+
+private:
+    explicit ShadowCache(QObject *parent = nullptr);
+    ShadowCache(const ShadowCache&) = delete;
+    ShadowCache& operator=(const ShadowCache&) = delete;
+
+    static QImage renderShadow(const QSize &maskSize, const ShadowSpec &spec, qreal devicePixelRatio);
+
+    QHash<QString, NinePatch> m_patches;
+};
+
+// DropShadowWidget - Paints a cached shadow beneath a sibling widget
+//
+// Replaces QGraphicsDropShadowEffect, which renders the target offscreen and
+// re-blurs it on every update inside it. This widget sits just under the
+// target in the same parent, follows its geometry and visibility, ignores
+// input, and only ever blits the nine-patch from ShadowCache. The blur
+// radius follows RenderQuality: halved at reduced, hidden at minimal.
+class DropShadowWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static DropShadowWidget *attach(QWidget *target, const ShadowSpec &spec);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    DropShadowWidget(QWidget *target, const ShadowSpec &spec);
+
+    void syncGeometry();
+    ShadowSpec effectiveSpec() const;
+
+    QPointer<QWidget> m_target;
+    ShadowSpec m_spec;
+};
+
+#endif // DROPSHADOW_H
@@ -0,0 +1,112 @@
+#include "flagatlas.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QFile>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr quint32 ATLAS_MAGIC = 0x50424641;  // "PBFA"
+    constexpr quint16 ATLAS_VERSION = 1;
+    const QString ATLAS_IMAGE = QStringLiteral(":/atlas/flags.png");
+    const QString ATLAS_INDEX = QStringLiteral(":/atlas/flags.idx");
+}
+
+// FlagAtlas - Owned by the application object so the pixmap never outlives QApplication
+FlagAtlas& FlagAtlas::instance()
+{
+    static FlagAtlas *instance = new FlagAtlas(QCoreApplication::instance());
+    return *instance;
+}
+
+FlagAtlas::FlagAtlas(QObject *parent)
+    : QObject(parent)
+    , m_flagSize(0)
+    , m_columns(0)
+    , m_padding(0)
+{
+    loadIndex();
+
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_pixmap = QPixmap();
+    });
+}
+
+void FlagAtlas::loadIndex()
+{
+    QFile file(ATLAS_INDEX);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0, flagSize = 0, columns = 0, padding = 0, scaleCount = 0;
+    in >> magic >> version >> flagSize >> columns >> padding >> scaleCount;
+    if (magic != ATLAS_MAGIC || version != ATLAS_VERSION || columns == 0) {
+        qDebug() << "Ignoring incompatible flag atlas index";
+        return;
+    }
+
+    m_flagSize = flagSize;
+    m_columns = columns;
+    m_padding = padding;
+
+    for (int i = 0; i < scaleCount; ++i) {
+        quint8 scale = 0;
+        quint32 offset = 0;
+        in >> scale >> offset;
+        m_scales.append(scale);
+        m_bandOffsets.insert(scale, static_cast<int>(offset));
+    }
+
+    quint32 count = 0;
+    in >> count;
+    for (quint32 slot = 0; slot < count && in.status() == QDataStream::Ok; ++slot) {
+        QByteArray code;
+        in >> code;
+        m_slots.insert(QString::fromLatin1(code), static_cast<int>(slot));
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Flag atlas index is truncated";
+        m_slots.clear();
+    }
+}
+
+int FlagAtlas::scaleFor(qreal devicePixelRatio) const
+{
+    // Smallest scale that does not upscale, otherwise the largest one packed
+    const int wanted = static_cast<int>(std::ceil(devicePixelRatio - 0.01));
+    int best = 0;
+    int largest = 0;
+    for (int scale : m_scales) {
+        largest = std::max(largest, scale);
+        if (scale >= wanted && (best == 0 || scale < best)) {
+            best = scale;
+        }
+    }
+    return best ? best : largest;
+}
+
+QRect FlagAtlas::sourceRect(const QString &countryCode, int scale) const
+{
+    auto it = m_slots.constFind(countryCode);
+    if (it == m_slots.constEnd() || !m_bandOffsets.contains(scale)) return QRect();
+
+    const int cell = m_flagSize * scale;
+    const int slot = it.value();
+    return QRect((slot % m_columns) * (cell + m_padding),
+                 m_bandOffsets.value(scale) + (slot / m_columns) * (cell + m_padding),
+                 cell, cell);
+}
+
+QPixmap FlagAtlas::pixmap()
+{
+    // Decoded lazily on first paint; every flag widget shares this one pixmap
+    if (m_pixmap.isNull() && isAvailable()) {
+        m_pixmap.load(ATLAS_IMAGE, "PNG");
+    }
+    return m_pixmap;
+}
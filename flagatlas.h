@@ -0,0 +1,48 @@
+#ifndef FLAGATLAS_H
+#define FLAGATLAS_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+// FlagAtlas - Build-time sprite atlas of every bundled flag
+//
+// The atlas is produced by the flagatlasgen target at 1x/2x/3x of
+// Config::FLAG_SIZE and embedded under :/atlas/. Painting a flag becomes a
+// blit of a sub-rect of one shared pixmap; no SVG is parsed at runtime.
+class FlagAtlas : public QObject
+{
+    Q_OBJECT
+
+public:
+    static FlagAtlas& instance();
+
+    bool isAvailable() const { return !m_slots.isEmpty(); }
+    bool contains(const QString &countryCode) const { return m_slots.contains(countryCode); }
+    QStringList countryCodes() const { return m_slots.keys(); }
+
+    // Picks the smallest packed scale that covers the device pixel ratio
+    int scaleFor(qreal devicePixelRatio) const;
+    QRect sourceRect(const QString &countryCode, int scale) const;
+    QPixmap pixmap();
+
+private:
+    explicit FlagAtlas(QObject *parent = nullptr);
+    FlagAtlas(const FlagAtlas&) = delete;
+    FlagAtlas& operator=(const FlagAtlas&) = delete;
+
+    void loadIndex();
+
+    int m_flagSize;
+    int m_columns;
+    int m_padding;
+    QHash<int, int> m_bandOffsets;  // scale -> y offset
+    QList<int> m_scales;
+    QHash<QString, int> m_slots;    // country code -> slot
+    QPixmap m_pixmap;
+};
+
+#endif // FLAGATLAS_H
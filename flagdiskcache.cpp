@@ -0,0 +1,141 @@
+#include "flagdiskcache.h"
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace {
+    const QString INDEX_FILE = QStringLiteral("index.json");
+}
+
+// FlagDiskCache - Lives for the whole process; holds no GUI objects
+FlagDiskCache& FlagDiskCache::instance()
+{
+    static FlagDiskCache instance;
+    return instance;
+}
+
+FlagDiskCache::FlagDiskCache()
+    : m_cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/flags")
+{
+    QDir().mkpath(m_cacheDir);
+    loadIndex();
+}
+
+QString FlagDiskCache::contentHash(const QByteArray &svgData)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(svgData, QCryptographicHash::Sha1).toHex());
+}
+
+void FlagDiskCache::loadIndex()
+{
+    QFile file(m_cacheDir + "/" + INDEX_FILE);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+        Entry entry;
+        entry.contentHash = obj["sha1"].toString();
+        entry.etag = obj["etag"].toString().toLatin1();
+        entry.lastModified = obj["lastModified"].toString().toLatin1();
+
+        // Drop index entries whose payload was removed from disk
+        if (!entry.contentHash.isEmpty() && QFile::exists(m_cacheDir + "/" + entry.contentHash + ".svg")) {
+            m_index.insert(it.key(), entry);
+        }
+    }
+}
+
+void FlagDiskCache::saveIndex() const
+{
+    QJsonObject root;
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        QJsonObject obj;
+        obj["sha1"] = it.value().contentHash;
+        obj["etag"] = QString::fromLatin1(it.value().etag);
+        obj["lastModified"] = QString::fromLatin1(it.value().lastModified);
+        root[it.key()] = obj;
+    }
+
+    QSaveFile file(m_cacheDir + "/" + INDEX_FILE);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Failed to write flag cache index:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+bool FlagDiskCache::lookup(const QString &flagUrl, Entry *entry) const
+{
+    auto it = m_index.constFind(flagUrl);
+    if (it == m_index.constEnd()) return false;
+
+    if (entry) *entry = it.value();
+    return true;
+}
+
+QByteArray FlagDiskCache::svgData(const QString &contentHash) const
+{
+    QFile file(m_cacheDir + "/" + contentHash + ".svg");
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    return file.readAll();
+}
+
+void FlagDiskCache::storeSvg(const QString &flagUrl, const QByteArray &svgData,
+                             const QByteArray &etag, const QByteArray &lastModified)
+{
+    Entry entry;
+    entry.contentHash = contentHash(svgData);
+    entry.etag = etag;
+    entry.lastModified = lastModified;
+
+    // Identical content is written only once regardless of how many URLs point at it
+    const QString path = m_cacheDir + "/" + entry.contentHash + ".svg";
+    if (!QFile::exists(path)) {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qDebug() << "Failed to write cached flag:" << file.errorString();
+            return;
+        }
+        file.write(svgData);
+        if (!file.commit()) return;
+    }
+
+    m_index.insert(flagUrl, entry);
+    saveIndex();
+}
+
+QString FlagDiskCache::rasterPath(const QString &contentHash, const QSize &pixelSize) const
+{
+    return QString("%1/%2-%3x%4.png").arg(m_cacheDir, contentHash)
+        .arg(pixelSize.width()).arg(pixelSize.height());
+}
+
+QPixmap FlagDiskCache::loadRaster(const QString &contentHash, const QSize &pixelSize) const
+{
+    QPixmap pixmap;
+    const QString path = rasterPath(contentHash, pixelSize);
+    if (QFile::exists(path)) {
+        pixmap.load(path, "PNG");
+    }
+    return pixmap;
+}
+
+void FlagDiskCache::storeRaster(const QString &contentHash, const QImage &image) const
+{
+    if (contentHash.isEmpty() || image.isNull()) return;
+
+    const QString path = rasterPath(contentHash, image.size());
+    if (QFile::exists(path)) return;
+
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && image.save(&file, "PNG")) {
+        file.commit();
+    }
+}
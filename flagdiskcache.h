@@ -0,0 +1,51 @@
+#ifndef FLAGDISKCACHE_H
+#define FLAGDISKCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QSize>
+#include <QPixmap>
+#include <QImage>
+
+// FlagDiskCache - Content-addressed on-disk store for downloaded flag SVGs
+//
+// SVG payloads are stored as <sha1>.svg and their rasterized pixmaps as
+// <sha1>-<w>x<h>.png under the application cache directory. A small JSON
+// index maps each flag URL to its content hash plus the ETag/Last-Modified
+// validators used for conditional revalidation.
+class FlagDiskCache
+{
+public:
+    struct Entry {
+        QString contentHash;
+        QByteArray etag;
+        QByteArray lastModified;
+    };
+
+    static FlagDiskCache& instance();
+    static QString contentHash(const QByteArray &svgData);
+
+    bool lookup(const QString &flagUrl, Entry *entry) const;
+    QByteArray svgData(const QString &contentHash) const;
+    void storeSvg(const QString &flagUrl, const QByteArray &svgData,
+                  const QByteArray &etag, const QByteArray &lastModified);
+
+    QPixmap loadRaster(const QString &contentHash, const QSize &pixelSize) const;
+    // Safe to call from worker threads; touches only files, never the index
+    void storeRaster(const QString &contentHash, const QImage &image) const;
+
+private:
+    FlagDiskCache();
+    FlagDiskCache(const FlagDiskCache&) = delete;
+    FlagDiskCache& operator=(const FlagDiskCache&) = delete;
+
+    void loadIndex();
+    void saveIndex() const;
+    QString rasterPath(const QString &contentHash, const QSize &pixelSize) const;
+
+    QString m_cacheDir;
+    QHash<QString, Entry> m_index;
+};
+
+#endif // FLAGDISKCACHE_H
@@ -0,0 +1,226 @@
+#include "flagloader.h"
+#include "flagdiskcache.h"
+#include "flagatlas.h"
+#include "networkservice.h"
+#include "assetpack.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QUrl>
+#include <algorithm>
+#include <utility>
+
+// FlagResolver - Bundled lookups are answered from the atlas and the asset pack index
+bool FlagResolver::isBundled(const QString &countryCode)
+{
+    static QHash<QString, bool> bundled;
+
+    auto it = bundled.constFind(countryCode);
+    if (it == bundled.constEnd()) {
+        it = bundled.insert(countryCode, FlagAtlas::instance().contains(countryCode)
+                                             || AssetPack::instance().contains(Config::FLAGS_ASSETS + countryCode + ".svg"));
+    }
+    return it.value();
+}
+
+QString FlagResolver::countryCode(const QString &source)
+{
+    const int slash = source.lastIndexOf('/');
+    const int dot = source.lastIndexOf('.');
+    if (dot <= slash) return QString();
+    return source.mid(slash + 1, dot - slash - 1);
+}
+
+QString FlagResolver::flagSource(const QString &countryCode)
+{
+    if (countryCode.isEmpty()) return QString();
+
+    const QString code = countryCode.toLower();
+    if (isBundled(code)) {
+        return Config::ASSET_SCHEME + Config::FLAGS_ASSETS + code + ".svg";
+    }
+    return Config::FLAGS_REMOTE_URL + code + ".svg";
+}
+
+// FlagLoader - Owned by the application object so it never outlives QApplication
+FlagLoader& FlagLoader::instance()
+{
+    static FlagLoader *instance = new FlagLoader(QCoreApplication::instance());
+    return *instance;
+}
+
+FlagLoader::FlagLoader(QObject *parent)
+    : QObject(parent)
+    , m_maxConcurrent(Config::FLAG_FETCH_CONCURRENCY)
+    , m_running(0)
+    , m_nextSequence(0)
+    , m_dispatchScheduled(false)
+{
+    NetworkService& network = NetworkService::instance();
+    connect(&network, &NetworkService::flagFetched, this, &FlagLoader::onFlagFetched);
+    connect(&network, &NetworkService::flagFetchFailed, this, &FlagLoader::onFlagFetchFailed);
+}
+
+void FlagLoader::setMaxConcurrentRequests(int count)
+{
+    m_maxConcurrent = std::max(1, count);
+    scheduleDispatch();
+}
+
+bool FlagLoader::hasRecentFailure(const QString &flagUrl) const
+{
+    auto it = m_failedUntil.constFind(flagUrl);
+    return it != m_failedUntil.constEnd() && QDateTime::currentMSecsSinceEpoch() < it.value();
+}
+
+bool FlagLoader::requestFlag(const QString &flagUrl, Priority priority)
+{
+    if (flagUrl.isEmpty()) return false;
+
+    if (hasRecentFailure(flagUrl)) {
+        return false;
+    }
+    m_failedUntil.remove(flagUrl);
+
+    // Coalesce with an already queued or running download for the same URL
+    auto it = m_inFlight.find(flagUrl);
+    if (it != m_inFlight.end()) {
+        it->hasWaiters = true;
+        it->priority = std::min(it->priority, priority);
+        return true;
+    }
+
+    enqueue(flagUrl, true, priority);
+    return true;
+}
+
+void FlagLoader::revalidateFlag(const QString &flagUrl)
+{
+    if (flagUrl.isEmpty() || m_revalidated.contains(flagUrl) || m_inFlight.contains(flagUrl)) return;
+    if (hasRecentFailure(flagUrl)) return;
+
+    enqueue(flagUrl, false, Priority::Background);
+}
+
+void FlagLoader::setPriority(const QString &flagUrl, Priority priority)
+{
+    auto it = m_inFlight.find(flagUrl);
+    if (it == m_inFlight.end() || it->running) return;
+
+    // The selected flag stays at the front even if its list row scrolls away
+    if (it->priority == Priority::Selected && priority != Priority::Selected) return;
+    it->priority = priority;
+}
+
+void FlagLoader::enqueue(const QString &flagUrl, bool hasWaiters, Priority priority)
+{
+    PendingRequest pending;
+    pending.hasWaiters = hasWaiters;
+    pending.priority = priority;
+    pending.sequence = m_nextSequence++;
+    m_inFlight.insert(flagUrl, pending);
+
+    scheduleDispatch();
+}
+
+void FlagLoader::scheduleDispatch()
+{
+    // Deferred so that priorities set right after construction still apply
+    if (m_dispatchScheduled) return;
+    m_dispatchScheduled = true;
+    QMetaObject::invokeMethod(this, &FlagLoader::dispatchQueued, Qt::QueuedConnection);
+}
+
+void FlagLoader::dispatchQueued()
+{
+    m_dispatchScheduled = false;
+
+    while (m_running < m_maxConcurrent) {
+        auto next = m_inFlight.end();
+        for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+            if (it->running) continue;
+            if (next == m_inFlight.end()
+                || std::make_pair(it->priority, it->sequence) < std::make_pair(next->priority, next->sequence)) {
+                next = it;
+            }
+        }
+        if (next == m_inFlight.end()) break;
+
+        startRequest(next.key(), next.value());
+    }
+}
+
+void FlagLoader::startRequest(const QString &flagUrl, PendingRequest &pending)
+{
+    FlagDiskCache::Entry entry;
+    FlagDiskCache::instance().lookup(flagUrl, &entry);
+
+    pending.running = true;
+    ++m_running;
+
+    NetworkService::instance().fetchFlag(flagUrl, entry.etag, entry.lastModified,
+                                         pending.priority == Priority::Selected);
+}
+
+void FlagLoader::finishRequest(const QString &flagUrl, bool *hasWaiters)
+{
+    auto it = m_inFlight.find(flagUrl);
+    if (it == m_inFlight.end()) return;
+
+    *hasWaiters = it->hasWaiters;
+    m_inFlight.erase(it);
+
+    --m_running;
+    scheduleDispatch();
+}
+
+void FlagLoader::markFailed(const QString &flagUrl)
+{
+    m_failedUntil.insert(flagUrl, QDateTime::currentMSecsSinceEpoch() + Config::FLAG_FAILURE_TTL_MS);
+    emit flagFailed(flagUrl);
+}
+
+void FlagLoader::onFlagFetchFailed(const QString &flagUrl, const QString &error)
+{
+    bool hasWaiters = false;
+    finishRequest(flagUrl, &hasWaiters);
+
+    qDebug() << "Flag download failed:" << flagUrl << error;
+    markFailed(flagUrl);
+}
+
+void FlagLoader::onFlagFetched(const QString &flagUrl, int statusCode, const QByteArray &svgData,
+                               const QByteArray &etag, const QByteArray &lastModified)
+{
+    bool hasWaiters = false;
+    finishRequest(flagUrl, &hasWaiters);
+
+    FlagDiskCache& diskCache = FlagDiskCache::instance();
+    FlagDiskCache::Entry entry;
+    const bool wasCached = diskCache.lookup(flagUrl, &entry);
+    m_revalidated.insert(flagUrl);
+
+    // Not modified - the copy on disk is still current
+    if (statusCode == 304 && wasCached) {
+        if (hasWaiters) {
+            emit flagLoaded(flagUrl, diskCache.svgData(entry.contentHash));
+        }
+        return;
+    }
+
+    if (svgData.isEmpty()) {
+        qDebug() << "Flag download returned no data:" << flagUrl;
+        markFailed(flagUrl);
+        return;
+    }
+
+    diskCache.storeSvg(flagUrl, svgData, etag, lastModified);
+
+    const bool changed = wasCached && entry.contentHash != FlagDiskCache::contentHash(svgData);
+    if (changed) {
+        emit flagInvalidated(flagUrl);
+    }
+    if (changed || hasWaiters) {
+        emit flagLoaded(flagUrl, svgData);
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef FLAGLOADER_H
+#define FLAGLOADER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QByteArray>
+#include "config.h"
+
+// FlagResolver - Maps a country code to the cheapest available flag source
+//
+// Flags shipped in the asset pack or packed into FlagAtlas are returned as
+// "asset:flags/<cc>.svg" and never touch the network; anything else falls
+// back to the remote circle-flags URL and goes through FlagLoader.
+class FlagResolver
+{
+public:
+    static QString flagSource(const QString &countryCode);
+    static bool isBundled(const QString &countryCode);
+    static bool isLocalSource(const QString &source) { return source.startsWith(Config::ASSET_SCHEME); }
+    // Name of a local source inside AssetPack, e.g. "flags/gb.svg"
+    static QString assetName(const QString &source) { return source.mid(Config::ASSET_SCHEME.size()); }
+    static QString countryCode(const QString &source);
+};
+
+// FlagLoader - Process-wide flag download service shared by all flag widgets
+//
+// Downloads run on the NetworkService I/O thread; this class only sees the
+// resulting bytes. Concurrent requests for the same URL are merged into a
+// single download and the result is fanned out to every subscriber through
+// flagLoaded/flagFailed.
+// Failed URLs are remembered for Config::FLAG_FAILURE_TTL_MS so that an
+// offline machine does not start a new timeout on every setFlag() call.
+// Downloads are persisted in FlagDiskCache and revalidated with
+// If-None-Match/If-Modified-Since at most once per session.
+//
+// At most maxConcurrentRequests() downloads run at once. Queued requests
+// start in priority order (selected flag, then visible rows, then
+// off-screen rows, then background revalidation) and can be reprioritized
+// while they wait, e.g. when the language list scrolls.
+class FlagLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Priority {
+        Selected = 0,
+        Visible,
+        Offscreen,
+        Background
+    };
+
+    static FlagLoader& instance();
+
+    // Returns false when the URL failed recently and no result will be delivered
+    bool requestFlag(const QString &flagUrl, Priority priority = Priority::Offscreen);
+    // Background conditional refresh of a flag already served from disk
+    void revalidateFlag(const QString &flagUrl);
+    void setPriority(const QString &flagUrl, Priority priority);
+    bool hasRecentFailure(const QString &flagUrl) const;
+    bool isLoading(const QString &flagUrl) const { return m_inFlight.contains(flagUrl); }
+
+    int maxConcurrentRequests() const { return m_maxConcurrent; }
+    void setMaxConcurrentRequests(int count);
+
+signals:
+    void flagLoaded(const QString &flagUrl, const QByteArray &svgData);
+    void flagFailed(const QString &flagUrl);
+    // Emitted before flagLoaded when revalidation found new content
+    void flagInvalidated(const QString &flagUrl);
+
+private slots:
+    void onFlagFetched(const QString &flagUrl, int statusCode, const QByteArray &svgData,
+                       const QByteArray &etag, const QByteArray &lastModified);
+    void onFlagFetchFailed(const QString &flagUrl, const QString &error);
+    void dispatchQueued();
+
+private:
+    struct PendingRequest {
+        bool running = false;
+        bool hasWaiters = false;
+        Priority priority = Priority::Offscreen;
+        quint64 sequence = 0;
+    };
+
+    explicit FlagLoader(QObject *parent = nullptr);
+    FlagLoader(const FlagLoader&) = delete;
+    FlagLoader& operator=(const FlagLoader&) = delete;
+
+    void enqueue(const QString &flagUrl, bool hasWaiters, Priority priority);
+    void scheduleDispatch();
+    void startRequest(const QString &flagUrl, PendingRequest &pending);
+    void finishRequest(const QString &flagUrl, bool *hasWaiters);
+    void markFailed(const QString &flagUrl);
+
+    QHash<QString, PendingRequest> m_inFlight;  // queued and running
+    int m_maxConcurrent;
+    int m_running;
+    quint64 m_nextSequence;
+    bool m_dispatchScheduled;
+    QHash<QString, qint64> m_failedUntil;  // URL -> msecs since epoch
+    QSet<QString> m_revalidated;
+};
+
+#endif // FLAGLOADER_H
@@ -0,0 +1,152 @@
+#include "flagrastercache.h"
+#include "flagdiskcache.h"
+#include <QCoreApplication>
+#include <QSvgRenderer>
+#include <QPainter>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <algorithm>
+
+// FlagRasterCache - Owned by the application object, emptied before GUI teardown
+FlagRasterCache& FlagRasterCache::instance()
+{
+    static FlagRasterCache *instance = new FlagRasterCache(QCoreApplication::instance());
+    return *instance;
+}
+
+FlagRasterCache::FlagRasterCache(QObject *parent)
+    : QObject(parent)
+    , m_cache(Config::FLAG_RASTER_CACHE_KB)
+{
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_cache.clear();
+    });
+}
+
+QSize FlagRasterCache::devicePixelSize(const QSize &logicalSize, qreal devicePixelRatio)
+{
+    return QSize(qRound(logicalSize.width() * devicePixelRatio),
+                 qRound(logicalSize.height() * devicePixelRatio));
+}
+
+QImage FlagRasterCache::rasterize(const QByteArray &svgData, const QSize &logicalSize,
+                                  qreal devicePixelRatio, int renderScale,
+                                  const std::atomic_bool *cancelled)
+{
+    if (cancelled && cancelled->load()) return QImage();
+
+    QSvgRenderer renderer(svgData);
+    const QSize deviceSize = devicePixelSize(logicalSize, devicePixelRatio);
+    if (!renderer.isValid() || deviceSize.isEmpty()) return QImage();
+
+    // The owning widget may have switched flags while we were parsing
+    if (cancelled && cancelled->load()) return QImage();
+
+    // Supersample once, never on paint
+    const QSize renderSize = (logicalSize * renderScale).expandedTo(deviceSize);
+    QImage image(renderSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    renderer.render(&painter, QRectF(0, 0, renderSize.width(), renderSize.height()));
+    painter.end();
+
+    if (renderSize != deviceSize) {
+        image = image.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    image.setDevicePixelRatio(devicePixelRatio);
+    return image;
+}
+
+QPixmap FlagRasterCache::fitToDevicePixels(const QPixmap &source, const QSize &logicalSize,
+                                           qreal devicePixelRatio)
+{
+    const QSize deviceSize = devicePixelSize(logicalSize, devicePixelRatio);
+    if (source.isNull() || deviceSize.isEmpty()) return QPixmap();
+
+    QPixmap pixmap = source.size() == deviceSize
+                         ? source
+                         : source.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    return pixmap;
+}
+
+QPixmap FlagRasterCache::find(const FlagRasterKey &key)
+{
+    QPixmap *pixmap = m_cache.object(key);
+    return pixmap ? *pixmap : QPixmap();
+}
+
+void FlagRasterCache::insert(const FlagRasterKey &key, const QPixmap &pixmap)
+{
+    if (pixmap.isNull()) return;
+
+    const qsizetype costKb = std::max<qsizetype>(1, qsizetype(pixmap.width()) * pixmap.height() * 4 / 1024);
+    m_cache.insert(key, new QPixmap(pixmap), costKb);
+}
+
+void FlagRasterCache::removeSource(const QString &source)
+{
+    const QList<FlagRasterKey> keys = m_cache.keys();
+    for (const FlagRasterKey &key : keys) {
+        if (key.source == source) {
+            m_cache.remove(key);
+        }
+    }
+}
+
+void FlagRasterCache::rasterizeAsync(const FlagRasterKey &key, const QByteArray &svgData,
+                                     int renderScale, const QString &diskHash)
+{
+    if (svgData.isEmpty()) return;
+
+    // Join a job that is already running for the same key
+    auto it = m_pending.find(key);
+    if (it != m_pending.end()) {
+        ++it->waiters;
+        return;
+    }
+
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    m_pending.insert(key, PendingJob{cancelled, 1});
+
+    auto *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, cancelled]() {
+        watcher->deleteLater();
+
+        // A cancelled job may have been replaced by a newer one for the same key
+        auto it = m_pending.find(key);
+        if (it != m_pending.end() && it->cancelled == cancelled) {
+            m_pending.erase(it);
+        }
+
+        const QImage image = watcher->result();
+        if (image.isNull()) return;
+
+        QPixmap pixmap = QPixmap::fromImage(image);
+        insert(key, pixmap);
+        emit rasterReady(key, pixmap);
+    });
+
+    watcher->setFuture(QtConcurrent::run([svgData, key, renderScale, diskHash, cancelled]() {
+        QImage image = FlagRasterCache::rasterize(svgData, key.logicalSize, key.devicePixelRatio,
+                                                  renderScale, cancelled.get());
+        if (!image.isNull() && !diskHash.isEmpty()) {
+            FlagDiskCache::instance().storeRaster(diskHash, image);
+        }
+        return image;
+    }));
+}
+
+void FlagRasterCache::cancel(const FlagRasterKey &key)
+{
+    auto it = m_pending.find(key);
+    if (it == m_pending.end()) return;
+
+    if (--it->waiters <= 0) {
+        it->cancelled->store(true);
+        m_pending.erase(it);
+    }
+}
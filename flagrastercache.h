@@ -0,0 +1,96 @@
+#ifndef FLAGRASTERCACHE_H
+#define FLAGRASTERCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QPixmap>
+#include <QHashFunctions>
+#include <atomic>
+#include <memory>
+#include "config.h"
+
+// FlagRasterKey - Identifies one rasterization of a flag asset
+struct FlagRasterKey
+{
+    QString source;
+    QSize logicalSize;
+    qreal devicePixelRatio = 1.0;
+};
+
+inline bool operator==(const FlagRasterKey &a, const FlagRasterKey &b)
+{
+    return a.source == b.source && a.logicalSize == b.logicalSize
+           && qRound(a.devicePixelRatio * 100) == qRound(b.devicePixelRatio * 100);
+}
+
+inline bool operator!=(const FlagRasterKey &a, const FlagRasterKey &b)
+{
+    return !(a == b);
+}
+
+inline size_t qHash(const FlagRasterKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.source, key.logicalSize.width(), key.logicalSize.height(),
+                      qRound(key.devicePixelRatio * 100));
+}
+
+// FlagRasterCache - Bounded LRU cache of rasterized flags
+//
+// Entries are keyed by (asset, logical size, device pixel ratio) and charged
+// by their pixel memory against Config::FLAG_RASTER_CACHE_KB. The cache is a
+// child of the application object and is emptied on aboutToQuit, so no
+// QPixmap survives the QApplication that backs it.
+//
+// SVG parsing and rendering run on QThreadPool::globalInstance() into a
+// QImage; only the QImage -> QPixmap conversion happens on the GUI thread.
+// Results are exactly device-pixel sized with the device pixel ratio set,
+// so painting them is a 1:1 blit; any supersampling is paid once here.
+// Identical keys share one job, and a job whose last waiter cancels is
+// skipped by the worker before it parses or renders anything.
+class FlagRasterCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static FlagRasterCache& instance();
+    static QSize devicePixelSize(const QSize &logicalSize, qreal devicePixelRatio);
+    // Renders at logicalSize * renderScale and downsamples once to device pixels
+    static QImage rasterize(const QByteArray &svgData, const QSize &logicalSize,
+                            qreal devicePixelRatio, int renderScale,
+                            const std::atomic_bool *cancelled = nullptr);
+    static QPixmap fitToDevicePixels(const QPixmap &source, const QSize &logicalSize,
+                                     qreal devicePixelRatio);
+
+    QPixmap find(const FlagRasterKey &key);
+    void insert(const FlagRasterKey &key, const QPixmap &pixmap);
+    void removeSource(const QString &source);
+
+    // Rasterizes on the global thread pool and emits rasterReady when done.
+    // A non-empty diskHash also writes the result to FlagDiskCache off-thread.
+    void rasterizeAsync(const FlagRasterKey &key, const QByteArray &svgData, int renderScale,
+                        const QString &diskHash = QString());
+    // Drops one waiter; the job is abandoned once nobody is waiting for it
+    void cancel(const FlagRasterKey &key);
+
+signals:
+    void rasterReady(const FlagRasterKey &key, const QPixmap &pixmap);
+
+private:
+    struct PendingJob {
+        std::shared_ptr<std::atomic_bool> cancelled;
+        int waiters = 0;
+    };
+
+    explicit FlagRasterCache(QObject *parent = nullptr);
+    FlagRasterCache(const FlagRasterCache&) = delete;
+    FlagRasterCache& operator=(const FlagRasterCache&) = delete;
+
+    QCache<FlagRasterKey, QPixmap> m_cache;
+    QHash<FlagRasterKey, PendingJob> m_pending;
+};
+
+#endif // FLAGRASTERCACHE_H
@@ -0,0 +1,47 @@
+#ifndef ICONDATA_H
+#define ICONDATA_H
+
+#include <QtGlobal>
+
+// IconData - Plain constexpr layout for icons compiled from SVG by svg2cpp
+//
+// Every path is flattened to absolute move/line/cubic/close commands in
+// viewBox units with all group transforms already applied, so painting
+// needs no XML, no CSS and no transform stack. IconPainter turns these
+// into QPainterPaths.
+namespace IconData {
+    enum class Op : quint8 { MoveTo, LineTo, CubicTo, Close };
+
+    // MoveTo/LineTo use v[0..1]; CubicTo uses c1, c2, end in v[0..5]
+    struct Command {
+        Op op;
+        float v[6];
+    };
+
+    enum class Paint : quint8 { None, Color, CurrentColor };
+    enum class Cap : quint8 { Flat, Round, Square };
+    enum class Join : quint8 { Miter, Round, Bevel };
+
+    struct Shape {
+        const Command *commands;
+        int commandCount;
+        bool windingFill;      // SVG nonzero; evenodd otherwise
+        Paint fill;
+        quint32 fillArgb;
+        Paint stroke;
+        quint32 strokeArgb;
+        float strokeWidth;
+        Cap cap;
+        Join join;
+    };
+
+    struct Icon {
+        const char *name;      // source file name, e.g. "check.svg"
+        float width;           // viewBox size
+        float height;
+        const Shape *shapes;
+        int shapeCount;
+    };
+}
+
+#endif // ICONDATA_H
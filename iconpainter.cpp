@@ -0,0 +1,83 @@
+#include "iconpainter.h"
+#include <QPainter>
+#include <QPen>
+
+namespace {
+    QColor resolveColor(IconData::Paint paint, quint32 argb, const QColor &currentColor)
+    {
+        return paint == IconData::Paint::CurrentColor ? currentColor : QColor::fromRgba(argb);
+    }
+
+    Qt::PenCapStyle penCap(IconData::Cap cap)
+    {
+        switch (cap) {
+        case IconData::Cap::Round: return Qt::RoundCap;
+        case IconData::Cap::Square: return Qt::SquareCap;
+        default: return Qt::FlatCap;
+        }
+    }
+
+    Qt::PenJoinStyle penJoin(IconData::Join join)
+    {
+        switch (join) {
+        case IconData::Join::Round: return Qt::RoundJoin;
+        case IconData::Join::Bevel: return Qt::BevelJoin;
+        default: return Qt::MiterJoin;
+        }
+    }
+}
+
+const QList<QPainterPath> &IconPainter::paths(const IconData::Icon &icon)
+{
+    static QHash<const IconData::Icon *, QList<QPainterPath>> cache;
+
+    auto it = cache.find(&icon);
+    if (it != cache.end()) return it.value();
+
+    QList<QPainterPath> result;
+    result.reserve(icon.shapeCount);
+    for (int s = 0; s < icon.shapeCount; ++s) {
+        const IconData::Shape &shape = icon.shapes[s];
+        QPainterPath path;
+        path.setFillRule(shape.windingFill ? Qt::WindingFill : Qt::OddEvenFill);
+        for (int i = 0; i < shape.commandCount; ++i) {
+            const IconData::Command &command = shape.commands[i];
+            const float *v = command.v;
+            switch (command.op) {
+            case IconData::Op::MoveTo: path.moveTo(v[0], v[1]); break;
+            case IconData::Op::LineTo: path.lineTo(v[0], v[1]); break;
+            case IconData::Op::CubicTo: path.cubicTo(v[0], v[1], v[2], v[3], v[4], v[5]); break;
+            case IconData::Op::Close: path.closeSubpath(); break;
+            }
+        }
+        result.append(path);
+    }
+    return cache.insert(&icon, result).value();
+}
+
+void IconPainter::paint(QPainter *painter, const IconData::Icon &icon, const QRectF &target,
+                        const QColor &currentColor)
+{
+    if (target.isEmpty() || icon.width <= 0 || icon.height <= 0) return;
+
+    const QList<QPainterPath> &iconPaths = paths(icon);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->translate(target.topLeft());
+    painter->scale(target.width() / icon.width, target.height() / icon.height);
+
+    for (int s = 0; s < icon.shapeCount; ++s) {
+        const IconData::Shape &shape = icon.shapes[s];
+        if (shape.fill != IconData::Paint::None) {
+            painter->fillPath(iconPaths.at(s), resolveColor(shape.fill, shape.fillArgb, currentColor));
+        }
+        if (shape.stroke != IconData::Paint::None && shape.strokeWidth > 0) {
+            QPen pen(resolveColor(shape.stroke, shape.strokeArgb, currentColor), shape.strokeWidth,
+                     Qt::SolidLine, penCap(shape.cap), penJoin(shape.join));
+            painter->strokePath(iconPaths.at(s), pen);
+        }
+    }
+
+    painter->restore();
+}
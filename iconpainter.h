@@ -0,0 +1,34 @@
+#ifndef ICONPAINTER_H
+#define ICONPAINTER_H
+
+#include <QColor>
+#include <QHash>
+#include <QList>
+#include <QPainterPath>
+#include <QRectF>
+#include <QSizeF>
+#include "icondata.h"
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+
+// IconPainter - Paints svg2cpp icons straight from their constexpr tables
+//
+// The QPainterPaths for an icon are built on first use and kept for the
+// lifetime of the process; after that painting an icon is a handful of
+// fillPath/strokePath calls with no QtSvg involved. GUI thread only.
+class IconPainter
+{
+public:
+    static QSizeF defaultSize(const IconData::Icon &icon) { return QSizeF(icon.width, icon.height); }
+
+    // Maps the icon's viewBox onto target; currentColor paints use currentColor
+    static void paint(QPainter *painter, const IconData::Icon &icon, const QRectF &target,
+                      const QColor &currentColor = Qt::black);
+
+private:
+    static const QList<QPainterPath> &paths(const IconData::Icon &icon);
+};
+
+#endif // ICONPAINTER_H
@@ -0,0 +1,333 @@
+#include "languagelist.h"
+#include "flagloader.h"
+#include "flagdiskcache.h"
+#include "flagatlas.h"
+#include "assetpack.h"
+#include "paintcache.h"
+#include "renderquality.h"
+#include "iconpainter.h"
+#include "generatedicons.h"
+#include <QApplication>
+#include <QPainter>
+#include <QPen>
+#include <QStaticText>
+#include <QStyle>
+
+// LanguageListModel - Flags are fetched lazily for painted rows only
+LanguageListModel::LanguageListModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_selectedRow(-1)
+    , m_devicePixelRatio(1.0)
+{
+    FlagLoader& loader = FlagLoader::instance();
+    connect(&loader, &FlagLoader::flagLoaded, this, &LanguageListModel::onFlagLoaded);
+    connect(&loader, &FlagLoader::flagFailed, this, &LanguageListModel::onFlagFailed);
+    connect(&loader, &FlagLoader::flagInvalidated, this, [](const QString &flagUrl) {
+        FlagRasterCache::instance().removeSource(flagUrl);
+    });
+    connect(&FlagRasterCache::instance(), &FlagRasterCache::rasterReady,
+            this, &LanguageListModel::onRasterReady);
+}
+
+void LanguageListModel::setLanguages(const QList<Locale> &languages)
+{
+    beginResetModel();
+    m_languages = languages;
+    m_flagSources.clear();
+    QList<QStringList> searchTerms;
+    for (const Locale &language : languages) {
+        m_flagSources.append(FlagResolver::flagSource(language.countryCode));
+        searchTerms.append({language.nativeName, language.englishName, language.code, language.countryCode});
+    }
+    m_searchIndex.build(searchTerms);
+    m_selectedRow = -1;
+    m_requested.clear();
+    demoteFlagRequests();
+    m_fetching.clear();
+    endResetModel();
+}
+
+int LanguageListModel::rowForCode(const QString &code, const QString &countryCode) const
+{
+    int first = -1;
+    for (int row = 0; row < m_languages.size(); ++row) {
+        const Locale &language = m_languages.at(row);
+        if (language.code != code) continue;
+        if (language.countryCode == countryCode) return row;
+        if (first < 0) first = row;
+    }
+    return first;
+}
+
+int LanguageListModel::rowForCountry(const QString &countryCode) const
+{
+    for (int row = 0; row < m_languages.size(); ++row) {
+        if (m_languages.at(row).countryCode == countryCode) return row;
+    }
+    return -1;
+}
+
+void LanguageListModel::setSelectedRow(int row)
+{
+    if (row < -1 || row >= m_languages.size() || row == m_selectedRow) return;
+
+    // Only the old and the new row repaint
+    const int previous = m_selectedRow;
+    m_selectedRow = row;
+    if (previous >= 0) {
+        emit dataChanged(index(previous), index(previous), {SelectedRole});
+    }
+    if (row >= 0) {
+        emit dataChanged(index(row), index(row), {SelectedRole});
+    }
+}
+
+int LanguageListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_languages.size());
+}
+
+QVariant LanguageListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_languages.size()) return QVariant();
+
+    const Locale &language = m_languages.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole: return QString("%1 (%2)").arg(language.nativeName, language.code);
+    case CodeRole: return language.code;
+    case NameRole: return language.nativeName;
+    case EnglishNameRole: return language.englishName;
+    case CountryCodeRole: return language.countryCode;
+    case FlagSourceRole: return m_flagSources.at(index.row());
+    case SelectedRole: return index.row() == m_selectedRow;
+    default: break;
+    }
+    return QVariant();
+}
+
+QPixmap LanguageListModel::flag(const QString &flagSource, qreal devicePixelRatio)
+{
+    if (flagSource.isEmpty()) return QPixmap();
+
+    m_devicePixelRatio = devicePixelRatio;
+    const FlagRasterKey key{flagSource, QSize(Config::FLAG_SIZE, Config::FLAG_SIZE), devicePixelRatio};
+    const QPixmap pixmap = FlagRasterCache::instance().find(key);
+    if (!pixmap.isNull()) return pixmap;
+
+    if (m_requested.contains(key)) {
+        // Painted again, so on screen again after a demotion
+        if (m_fetching.contains(flagSource)) {
+            FlagLoader::instance().setPriority(flagSource, FlagLoader::Priority::Visible);
+        }
+        return pixmap;
+    }
+    return requestFlag(key);
+}
+
+void LanguageListModel::demoteFlagRequests()
+{
+    // Rows that left the viewport must not hold up the ones on screen
+    FlagLoader& loader = FlagLoader::instance();
+    for (const QString &source : std::as_const(m_fetching)) {
+        loader.setPriority(source, FlagLoader::Priority::Offscreen);
+    }
+}
+
+QPixmap LanguageListModel::requestFlag(const FlagRasterKey &key)
+{
+    FlagRasterCache& rasterCache = FlagRasterCache::instance();
+    const qreal dpr = key.devicePixelRatio;
+    const int renderScale = RenderQuality::instance().flagRenderScale(dpr);
+
+    // Packed flags: one cell of the atlas, resampled once for fractional ratios
+    if (FlagResolver::isLocalSource(key.source)) {
+        FlagAtlas& atlas = FlagAtlas::instance();
+        const QString countryCode = FlagResolver::countryCode(key.source);
+        const QRect cell = atlas.contains(countryCode) ? atlas.sourceRect(countryCode, atlas.scaleFor(dpr)) : QRect();
+        if (!cell.isNull()) {
+            const QPixmap pixmap = FlagRasterCache::fitToDevicePixels(atlas.pixmap().copy(cell), key.logicalSize, dpr);
+            rasterCache.insert(key, pixmap);
+            return pixmap;
+        }
+
+        const QByteArray svgData = AssetPack::instance().data(FlagResolver::assetName(key.source));
+        if (!svgData.isEmpty()) {
+            m_requested.insert(key);
+            rasterCache.rasterizeAsync(key, svgData, renderScale);
+        }
+        return QPixmap();
+    }
+
+    // Warm start from the persistent cache, refreshed in the background
+    FlagDiskCache& diskCache = FlagDiskCache::instance();
+    FlagDiskCache::Entry entry;
+    if (diskCache.lookup(key.source, &entry)) {
+        FlagLoader::instance().revalidateFlag(key.source);
+
+        QPixmap pixmap = diskCache.loadRaster(entry.contentHash, FlagRasterCache::devicePixelSize(key.logicalSize, dpr));
+        if (!pixmap.isNull()) {
+            pixmap.setDevicePixelRatio(dpr);
+            rasterCache.insert(key, pixmap);
+            return pixmap;
+        }
+
+        const QByteArray svgData = diskCache.svgData(entry.contentHash);
+        if (!svgData.isEmpty()) {
+            m_requested.insert(key);
+            rasterCache.rasterizeAsync(key, svgData, renderScale, entry.contentHash);
+            return QPixmap();
+        }
+    }
+
+    // A recent failure is not recorded, so the row retries once the failure expires
+    if (FlagLoader::instance().requestFlag(key.source, FlagLoader::Priority::Visible)) {
+        m_requested.insert(key);
+        m_fetching.insert(key.source);
+    }
+    return QPixmap();
+}
+
+void LanguageListModel::onFlagLoaded(const QString &flagUrl, const QByteArray &svgData)
+{
+    if (!m_flagSources.contains(flagUrl)) return;
+    m_fetching.remove(flagUrl);
+
+    // Rasterized at the ratio the list was last painted at
+    const FlagRasterKey key{flagUrl, QSize(Config::FLAG_SIZE, Config::FLAG_SIZE), m_devicePixelRatio};
+    if (!FlagRasterCache::instance().find(key).isNull()) {
+        m_requested.remove(key);
+        notifyFlagChanged(flagUrl);
+        return;
+    }
+
+    m_requested.insert(key);
+    FlagRasterCache::instance().rasterizeAsync(key, svgData, RenderQuality::instance().flagRenderScale(m_devicePixelRatio),
+                                               FlagDiskCache::contentHash(svgData));
+}
+
+void LanguageListModel::onFlagFailed(const QString &flagUrl)
+{
+    m_fetching.remove(flagUrl);
+    m_requested.removeIf([&flagUrl](const FlagRasterKey &key) { return key.source == flagUrl; });
+}
+
+void LanguageListModel::onRasterReady(const FlagRasterKey &key, const QPixmap &pixmap)
+{
+    Q_UNUSED(pixmap);
+    if (!m_requested.remove(key)) return;
+
+    notifyFlagChanged(key.source);
+}
+
+void LanguageListModel::notifyFlagChanged(const QString &source)
+{
+    for (int row = 0; row < m_flagSources.size(); ++row) {
+        if (m_flagSources.at(row) == source) {
+            emit dataChanged(index(row), index(row), {Qt::DecorationRole});
+        }
+    }
+}
+
+// LanguageFilterModel - One index lookup per query, one bit test per row
+LanguageFilterModel::LanguageFilterModel(LanguageListModel *source, QObject *parent)
+    : QSortFilterProxyModel(parent)
+    , m_source(source)
+{
+    setSourceModel(source);
+}
+
+void LanguageFilterModel::setQuery(const QString &query)
+{
+    const QString trimmed = query.trimmed();
+    if (trimmed == m_query) return;
+
+    m_query = trimmed;
+    m_matches = m_query.isEmpty() ? QBitArray() : m_source->search(m_query);
+    invalidateFilter();
+}
+
+bool LanguageFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    Q_UNUSED(sourceParent);
+    return m_matches.isEmpty() || (sourceRow < m_matches.size() && m_matches.testBit(sourceRow));
+}
+
+// LanguageItemDelegate - Row geometry, in logical pixels
+namespace {
+    constexpr int ROW_LEFT_MARGIN = 12;
+    constexpr int ROW_RIGHT_MARGIN = 35;
+    constexpr int ROW_SPACING = 12;
+    constexpr int CHECKMARK_SIZE = 22;
+}
+
+LanguageItemDelegate::LanguageItemDelegate(LanguageListModel *model, QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_model(model)
+    , m_font("Segoe UI", -1, QFont::Medium)
+    , m_textColor(26, 26, 26)
+{
+    m_font.setPixelSize(15);
+}
+
+void LanguageItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const
+{
+    // Background only; the style sheet's hover/selected rules apply as before
+    QStyleOptionViewItem background = option;
+    initStyleOption(&background, index);
+    background.text.clear();
+    background.features.setFlag(QStyleOptionViewItem::HasDisplay, false);
+    if (index.data(LanguageListModel::SelectedRole).toBool()) {
+        background.state |= QStyle::State_Selected;
+    }
+    QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &background, painter, option.widget);
+
+    const QRect row = option.rect;
+    const QRect flagRect(row.left() + ROW_LEFT_MARGIN, row.top() + (row.height() - Config::FLAG_SIZE) / 2,
+                         Config::FLAG_SIZE, Config::FLAG_SIZE);
+    const QRect checkRect(row.right() - ROW_RIGHT_MARGIN - CHECKMARK_SIZE + 1,
+                          row.top() + (row.height() - CHECKMARK_SIZE) / 2, CHECKMARK_SIZE, CHECKMARK_SIZE);
+    const QRect textRect(flagRect.right() + 1 + ROW_SPACING, row.top(),
+                         checkRect.left() - ROW_SPACING - (flagRect.right() + 1 + ROW_SPACING), row.height());
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    // Device-pixel raster, 1:1 blit; a grey disc until it arrives
+    const QPixmap flag = m_model->flag(index.data(LanguageListModel::FlagSourceRole).toString(),
+                                       painter->device()->devicePixelRatioF());
+    if (!flag.isNull()) {
+        painter->drawPixmap(flagRect.topLeft(), flag);
+    } else {
+        painter->setBrush(QColor(245, 245, 245, 200));
+        painter->setPen(QPen(QColor(220, 220, 220), 1));
+        painter->drawEllipse(flagRect.adjusted(2, 2, -2, -2));
+    }
+
+    const QStaticText text = PaintCache::instance().staticText(index.data(Qt::DisplayRole).toString(), m_font);
+    painter->setClipRect(textRect);
+    painter->setFont(m_font);
+    painter->setPen(m_textColor);
+    painter->drawStaticText(QPointF(textRect.left(), textRect.top() + (textRect.height() - text.size().height()) / 2),
+                            text);
+    painter->setClipping(false);
+
+    if (index.data(LanguageListModel::SelectedRole).toBool()) {
+        const QPixmap check = PaintCache::instance().state("language-list/check", checkRect.size(),
+                                                           painter->device()->devicePixelRatioF(),
+            [](QPainter *checkPainter, const QSize &size) {
+                IconPainter::paint(checkPainter, GeneratedIcons::CHECK, QRectF(QPointF(0, 0), size));
+            });
+        painter->drawPixmap(checkRect.topLeft(), check);
+    }
+
+    painter->restore();
+}
+
+QSize LanguageItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+    return QSize(Config::DROPDOWN_WIDTH, Config::DROPDOWN_ITEM_HEIGHT);
+}
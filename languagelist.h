@@ -0,0 +1,128 @@
+#ifndef LANGUAGELIST_H
+#define LANGUAGELIST_H
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QFont>
+#include <QList>
+#include <QPixmap>
+#include <QSet>
+#include <QStringList>
+#include <QSortFilterProxyModel>
+#include <QStyledItemDelegate>
+#include "flagrastercache.h"
+#include "localeindex.h"
+#include "locales.h"
+
+// LanguageListModel - The languages offered by ModernLanguageDropdown
+//
+// One row per language; which row is chosen is model state (SelectedRole),
+// not a property of any widget. Flags are not part of data() because the
+// raster depends on the device pixel ratio of the view painting it:
+// flag() returns the cached raster, or a null pixmap after starting the
+// fetch/rasterization, and dataChanged(DecorationRole) follows once it is
+// ready. Only rows that actually get painted ever request a flag, at
+// Visible priority; demoteFlagRequests() drops every pending download to
+// Offscreen when the view scrolls, filters or closes, and the next paint
+// promotes the rows still on screen again. The names and codes of every
+// row are indexed once for search().
+class LanguageListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        CodeRole = Qt::UserRole,
+        NameRole,
+        EnglishNameRole,
+        CountryCodeRole,
+        FlagSourceRole,
+        SelectedRole
+    };
+
+    explicit LanguageListModel(QObject *parent = nullptr);
+
+    void setLanguages(const QList<Locale> &languages);
+    const Locale &language(int row) const { return m_languages.at(row); }
+    // Row with the language code, preferring the given country; -1 if none
+    int rowForCode(const QString &code, const QString &countryCode = QString()) const;
+    int rowForCountry(const QString &countryCode) const;
+
+    int selectedRow() const { return m_selectedRow; }
+    void setSelectedRow(int row);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // One bit per row, see LocaleIndex
+    QBitArray search(QStringView query) const { return m_searchIndex.match(query); }
+
+    QPixmap flag(const QString &flagSource, qreal devicePixelRatio);
+
+public slots:
+    void demoteFlagRequests();
+
+private slots:
+    void onFlagLoaded(const QString &flagUrl, const QByteArray &svgData);
+    void onFlagFailed(const QString &flagUrl);
+    void onRasterReady(const FlagRasterKey &key, const QPixmap &pixmap);
+
+private:
+    QPixmap requestFlag(const FlagRasterKey &key);
+    void notifyFlagChanged(const QString &source);
+
+    QList<Locale> m_languages;
+    QStringList m_flagSources;      // per row, from FlagResolver
+    LocaleIndex m_searchIndex;
+    int m_selectedRow;
+    qreal m_devicePixelRatio;       // of the last flag() call
+    QSet<FlagRasterKey> m_requested;
+    QSet<QString> m_fetching;       // sources queued with FlagLoader by this model
+};
+
+// LanguageFilterModel - The rows of LanguageListModel matching a search query
+//
+// The source model answers the query from its index; filterAcceptsRow is a
+// bit lookup, so typing re-filters the same rows without rebuilding them.
+class LanguageFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit LanguageFilterModel(LanguageListModel *source, QObject *parent = nullptr);
+
+    void setQuery(const QString &query);
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    LanguageListModel *m_source;
+    QString m_query;
+    QBitArray m_matches;    // empty while the query is empty
+};
+
+// LanguageItemDelegate - Paints a language row: flag, "Name (CODE)", checkmark
+//
+// Row backgrounds still come from the ::item rules of the list's style
+// sheet (the selected language is drawn with the :selected state); flag,
+// text and checkmark are painted directly, so a row costs no widgets.
+class LanguageItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit LanguageItemDelegate(LanguageListModel *model, QObject *parent = nullptr);
+
+    void setTextColor(const QColor &color) { m_textColor = color; }
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    LanguageListModel *m_model;
+    QFont m_font;
+    QColor m_textColor;
+};
+
+#endif // LANGUAGELIST_H
@@ -0,0 +1,130 @@
+#include "localeindex.h"
+#include <algorithm>
+
+namespace {
+    // Words are runs of letters, digits and the marks that belong to them
+    QStringList splitWords(const QString &folded)
+    {
+        QStringList words;
+        qsizetype start = -1;
+        for (qsizetype i = 0; i <= folded.size(); ++i) {
+            const bool inWord = i < folded.size() && (folded.at(i).isLetterOrNumber() || folded.at(i).isMark());
+            if (inWord && start < 0) {
+                start = i;
+            } else if (!inWord && start >= 0) {
+                words.append(folded.mid(start, i - start));
+                start = -1;
+            }
+        }
+        return words;
+    }
+}
+
+QString LocaleIndex::fold(QStringView text)
+{
+    const QString decomposed = text.toString().normalized(QString::NormalizationForm_KD).toCaseFolded();
+
+    QString folded;
+    folded.reserve(decomposed.size());
+    for (const QChar c : decomposed) {
+        if (c.category() == QChar::Mark_NonSpacing) continue;
+
+        // Letters that do not decompose into a base letter and a mark
+        switch (c.unicode()) {
+        case u'ß': folded += QLatin1String("ss"); break;
+        case u'æ': folded += QLatin1String("ae"); break;
+        case u'œ': folded += QLatin1String("oe"); break;
+        case u'þ': folded += QLatin1String("th"); break;
+        case u'ø': folded += u'o'; break;
+        case u'ł': folded += u'l'; break;
+        case u'đ':
+        case u'ð': folded += u'd'; break;
+        case u'ı': folded += u'i'; break;
+        default: folded += c; break;
+        }
+    }
+    return folded;
+}
+
+quint64 LocaleIndex::trigram(QStringView text, qsizetype at)
+{
+    return (quint64(text.at(at).unicode()) << 32) | (quint64(text.at(at + 1).unicode()) << 16)
+           | text.at(at + 2).unicode();
+}
+
+void LocaleIndex::build(const QList<QStringList> &entries)
+{
+    m_words.clear();
+    m_trigrams.clear();
+    m_folded.clear();
+
+    for (int entry = 0; entry < entries.size(); ++entry) {
+        QStringList terms;
+        for (const QString &term : entries.at(entry)) {
+            const QString folded = fold(term);
+            terms.append(folded);
+            for (const QString &word : splitWords(folded)) {
+                m_words.push_back({word, entry});
+            }
+            for (qsizetype i = 0; i + 3 <= folded.size(); ++i) {
+                QList<int> &entriesWithTrigram = m_trigrams[trigram(folded, i)];
+                if (entriesWithTrigram.isEmpty() || entriesWithTrigram.last() != entry) {
+                    entriesWithTrigram.append(entry);
+                }
+            }
+        }
+        m_folded.append(terms.join(u'\n'));
+    }
+
+    std::sort(m_words.begin(), m_words.end(), [](const Word &a, const Word &b) {
+        return a.text < b.text;
+    });
+}
+
+QBitArray LocaleIndex::match(QStringView query) const
+{
+    QBitArray result(size(), true);
+    for (const QString &word : splitWords(fold(query))) {
+        QBitArray hits(size());
+        matchPrefix(word, &hits);
+        if (word.size() >= 3) {
+            matchSubstring(word, &hits);
+        }
+        result &= hits;
+    }
+    return result;
+}
+
+void LocaleIndex::matchPrefix(const QString &word, QBitArray *hits) const
+{
+    // Words sharing a prefix are contiguous in the sorted list
+    auto it = std::lower_bound(m_words.begin(), m_words.end(), word, [](const Word &a, const QString &text) {
+        return a.text < text;
+    });
+    for (; it != m_words.end() && it->text.startsWith(word); ++it) {
+        hits->setBit(it->entry);
+    }
+}
+
+void LocaleIndex::matchSubstring(const QString &word, QBitArray *hits) const
+{
+    QList<const QList<int> *> lists;
+    for (qsizetype i = 0; i + 3 <= word.size(); ++i) {
+        auto it = m_trigrams.constFind(trigram(word, i));
+        if (it == m_trigrams.constEnd()) return;
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QList<int> *a, const QList<int> *b) {
+        return a->size() < b->size();
+    });
+
+    // Candidates from the rarest trigram must appear in every other list, then hold the whole word
+    for (const int entry : *lists.first()) {
+        const bool inAll = std::all_of(lists.cbegin() + 1, lists.cend(), [entry](const QList<int> *list) {
+            return std::binary_search(list->cbegin(), list->cend(), entry);
+        });
+        if (inAll && m_folded.at(entry).contains(word)) {
+            hits->setBit(entry);
+        }
+    }
+}
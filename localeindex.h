@@ -0,0 +1,51 @@
+#ifndef LOCALEINDEX_H
+#define LOCALEINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <vector>
+
+// LocaleIndex - Type-ahead search over a fixed list of entries
+//
+// Each entry is a few terms (names, codes) that are folded once at build
+// time: compatibility-decomposed, stripped of combining marks and case
+// folded, so "espanol" finds "Español" and "turkce" finds "Türkçe". A
+// query is folded the same way and split into words; an entry matches when
+// every word is a prefix of one of its words or, from three characters on,
+// a substring of one of its terms.
+//
+// Prefixes come from a sorted word list (binary search); substrings from a
+// trigram -> entries table whose smallest posting lists are intersected
+// before the few candidates are verified. Nothing is allocated per entry
+// at query time.
+class LocaleIndex
+{
+public:
+    void build(const QList<QStringList> &entries);
+    int size() const { return int(m_folded.size()); }
+
+    // One bit per entry; an empty query matches everything
+    QBitArray match(QStringView query) const;
+
+    static QString fold(QStringView text);
+
+private:
+    struct Word {
+        QString text;
+        int entry;
+    };
+
+    static quint64 trigram(QStringView text, qsizetype at);
+    void matchPrefix(const QString &word, QBitArray *hits) const;
+    void matchSubstring(const QString &word, QBitArray *hits) const;
+
+    std::vector<Word> m_words;                  // sorted by text
+    QHash<quint64, QList<int>> m_trigrams;      // ascending, unique entries
+    QStringList m_folded;                       // per entry, terms joined by '\n'
+};
+
+#endif // LOCALEINDEX_H
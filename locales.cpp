@@ -0,0 +1,219 @@
+#include "locales.h"
+
+const QList<Locale> &Locales::all()
+{
+    static const QList<Locale> locales = {
+        {"Nederlands", "Dutch", "NL", "nl"},
+        {"English (US)", "English (United States)", "EN", "us"},
+        {"English (UK)", "English (United Kingdom)", "EN", "gb"},
+        {"Deutsch", "German", "DE", "de"},
+        {"Français", "French", "FR", "fr"},
+        {"Español", "Spanish", "ES", "es"},
+        {"Italiano", "Italian", "IT", "it"},
+        {"Português", "Portuguese", "PT", "pt"},
+        {"Русский", "Russian", "RU", "ru"},
+        {"中文", "Chinese", "CN", "cn"},
+        {"日本語", "Japanese", "JP", "jp"},
+        {"한국어", "Korean", "KR", "kr"},
+
+        {"Afrikaans", "Afrikaans", "AF", "za"},
+        {"Shqip", "Albanian", "SQ", "al"},
+        {"አማርኛ", "Amharic", "AM", "et"},
+        {"العربية (الجزائر)", "Arabic (Algeria)", "AR", "dz"},
+        {"العربية (البحرين)", "Arabic (Bahrain)", "AR", "bh"},
+        {"العربية (مصر)", "Arabic (Egypt)", "AR", "eg"},
+        {"العربية (العراق)", "Arabic (Iraq)", "AR", "iq"},
+        {"العربية (الأردن)", "Arabic (Jordan)", "AR", "jo"},
+        {"العربية (الكويت)", "Arabic (Kuwait)", "AR", "kw"},
+        {"العربية (لبنان)", "Arabic (Lebanon)", "AR", "lb"},
+        {"العربية (ليبيا)", "Arabic (Libya)", "AR", "ly"},
+        {"العربية (المغرب)", "Arabic (Morocco)", "AR", "ma"},
+        {"العربية (عُمان)", "Arabic (Oman)", "AR", "om"},
+        {"العربية (قطر)", "Arabic (Qatar)", "AR", "qa"},
+        {"العربية (السعودية)", "Arabic (Saudi Arabia)", "AR", "sa"},
+        {"العربية (السودان)", "Arabic (Sudan)", "AR", "sd"},
+        {"العربية (سوريا)", "Arabic (Syria)", "AR", "sy"},
+        {"العربية (تونس)", "Arabic (Tunisia)", "AR", "tn"},
+        {"العربية (الإمارات)", "Arabic (United Arab Emirates)", "AR", "ae"},
+        {"العربية (اليمن)", "Arabic (Yemen)", "AR", "ye"},
+        {"Հայերեն", "Armenian", "HY", "am"},
+        {"Aymar aru", "Aymara", "AY", "bo"},
+        {"Azərbaycan", "Azerbaijani", "AZ", "az"},
+        {"Euskara", "Basque", "EU", "es-pv"},
+        {"Беларуская", "Belarusian", "BE", "by"},
+        {"বাংলা", "Bengali", "BN", "bd"},
+        {"বাংলা (ভারত)", "Bengali (India)", "BN", "in"},
+        {"Bislama", "Bislama", "BI", "vu"},
+        {"Bosanski", "Bosnian", "BS", "ba"},
+        {"Brezhoneg", "Breton", "BR", "fr"},
+        {"Български", "Bulgarian", "BG", "bg"},
+        {"မြန်မာ", "Burmese", "MY", "mm"},
+        {"Català", "Catalan", "CA", "es-ct"},
+        {"Català (Andorra)", "Catalan (Andorra)", "CA", "ad"},
+        {"Chichewa", "Chichewa", "NY", "mw"},
+        {"中文 (香港)", "Chinese (Hong Kong)", "CN", "hk"},
+        {"中文 (澳門)", "Chinese (Macau)", "CN", "mo"},
+        {"中文 (新加坡)", "Chinese (Singapore)", "CN", "sg"},
+        {"中文 (台灣)", "Chinese (Taiwan)", "CN", "tw"},
+        {"Corsu", "Corsican", "CO", "fr"},
+        {"Hrvatski", "Croatian", "HR", "hr"},
+        {"Čeština", "Czech", "CS", "cz"},
+        {"Dansk", "Danish", "DA", "dk"},
+        {"ދިވެހި", "Divehi", "DV", "mv"},
+        {"Nederlands (België)", "Dutch (Belgium)", "NL", "be"},
+        {"Nederlands (Suriname)", "Dutch (Suriname)", "NL", "sr"},
+        {"རྫོང་ཁ", "Dzongkha", "DZ", "bt"},
+        {"English (Australia)", "English (Australia)", "EN", "au"},
+        {"English (Canada)", "English (Canada)", "EN", "ca"},
+        {"English (Ghana)", "English (Ghana)", "EN", "gh"},
+        {"English (Hong Kong)", "English (Hong Kong)", "EN", "hk"},
+        {"English (India)", "English (India)", "EN", "in"},
+        {"English (Ireland)", "English (Ireland)", "EN", "ie"},
+        {"English (Jamaica)", "English (Jamaica)", "EN", "jm"},
+        {"English (Kenya)", "English (Kenya)", "EN", "ke"},
+        {"English (Malaysia)", "English (Malaysia)", "EN", "my"},
+        {"English (Malta)", "English (Malta)", "EN", "mt"},
+        {"English (New Zealand)", "English (New Zealand)", "EN", "nz"},
+        {"English (Nigeria)", "English (Nigeria)", "EN", "ng"},
+        {"English (Pakistan)", "English (Pakistan)", "EN", "pk"},
+        {"English (Philippines)", "English (Philippines)", "EN", "ph"},
+        {"English (Singapore)", "English (Singapore)", "EN", "sg"},
+        {"English (South Africa)", "English (South Africa)", "EN", "za"},
+        {"Eesti", "Estonian", "ET", "ee"},
+        {"Føroyskt", "Faroese", "FO", "fo"},
+        {"Na Vosa Vakaviti", "Fijian", "FJ", "fj"},
+        {"Filipino", "Filipino", "TL", "ph"},
+        {"Suomi", "Finnish", "FI", "fi"},
+        {"Français (Belgique)", "French (Belgium)", "FR", "be"},
+        {"Français (Cameroun)", "French (Cameroon)", "FR", "cm"},
+        {"Français (Canada)", "French (Canada)", "FR", "ca"},
+        {"Français (Côte d’Ivoire)", "French (Côte d’Ivoire)", "FR", "ci"},
+        {"Français (Haïti)", "French (Haiti)", "FR", "ht"},
+        {"Français (Luxembourg)", "French (Luxembourg)", "FR", "lu"},
+        {"Français (Monaco)", "French (Monaco)", "FR", "mc"},
+        {"Français (Maroc)", "French (Morocco)", "FR", "ma"},
+        {"Français (Sénégal)", "French (Senegal)", "FR", "sn"},
+        {"Français (Suisse)", "French (Switzerland)", "FR", "ch"},
+        {"Frysk", "Frisian", "FY", "nl"},
+        {"Galego", "Galician", "GL", "es-ga"},
+        {"ქართული", "Georgian", "KA", "ge"},
+        {"Deutsch (Österreich)", "German (Austria)", "DE", "at"},
+        {"Deutsch (Liechtenstein)", "German (Liechtenstein)", "DE", "li"},
+        {"Deutsch (Luxemburg)", "German (Luxembourg)", "DE", "lu"},
+        {"Deutsch (Schweiz)", "German (Switzerland)", "DE", "ch"},
+        {"Ελληνικά", "Greek", "EL", "gr"},
+        {"Ελληνικά (Κύπρος)", "Greek (Cyprus)", "EL", "cy"},
+        {"Kalaallisut", "Greenlandic", "KL", "gl"},
+        {"Avañe’ẽ", "Guarani", "GN", "py"},
+        {"ગુજરાતી", "Gujarati", "GU", "in"},
+        {"Kreyòl ayisyen", "Haitian Creole", "HT", "ht"},
+        {"Hausa", "Hausa", "HA", "ng"},
+        {"עברית", "Hebrew", "HE", "il"},
+        {"हिन्दी", "Hindi", "HI", "in"},
+        {"Magyar", "Hungarian", "HU", "hu"},
+        {"Íslenska", "Icelandic", "IS", "is"},
+        {"Igbo", "Igbo", "IG", "ng"},
+        {"Bahasa Indonesia", "Indonesian", "ID", "id"},
+        {"Gaeilge", "Irish", "GA", "ie"},
+        {"Italiano (San Marino)", "Italian (San Marino)", "IT", "sm"},
+        {"Italiano (Svizzera)", "Italian (Switzerland)", "IT", "ch"},
+        {"ಕನ್ನಡ", "Kannada", "KN", "in"},
+        {"Қазақ тілі", "Kazakh", "KK", "kz"},
+        {"ខ្មែរ", "Khmer", "KM", "kh"},
+        {"Kinyarwanda", "Kinyarwanda", "RW", "rw"},
+        {"Ikirundi", "Kirundi", "RN", "bi"},
+        {"Kurdî", "Kurdish", "KU", "iq"},
+        {"Кыргызча", "Kyrgyz", "KY", "kg"},
+        {"ລາວ", "Lao", "LO", "la"},
+        {"Latviešu", "Latvian", "LV", "lv"},
+        {"Lingála", "Lingala", "LN", "cd"},
+        {"Lietuvių", "Lithuanian", "LT", "lt"},
+        {"Lëtzebuergesch", "Luxembourgish", "LB", "lu"},
+        {"Македонски", "Macedonian", "MK", "mk"},
+        {"Malagasy", "Malagasy", "MG", "mg"},
+        {"Bahasa Melayu", "Malay", "MS", "my"},
+        {"മലയാളം", "Malayalam", "ML", "in"},
+        {"Malti", "Maltese", "MT", "mt"},
+        {"Te Reo Māori", "Maori", "MI", "nz"},
+        {"मराठी", "Marathi", "MR", "in"},
+        {"Kajin M̧ajeļ", "Marshallese", "MH", "mh"},
+        {"Монгол", "Mongolian", "MN", "mn"},
+        {"नेपाली", "Nepali", "NE", "np"},
+        {"Davvisámegiella", "Northern Sami", "SE", "no"},
+        {"Norsk bokmål", "Norwegian Bokmål", "NB", "no"},
+        {"Norsk nynorsk", "Norwegian Nynorsk", "NN", "no"},
+        {"ଓଡ଼ିଆ", "Odia", "OR", "in"},
+        {"Oromoo", "Oromo", "OM", "et"},
+        {"پښتو", "Pashto", "PS", "af"},
+        {"فارسی", "Persian", "FA", "ir"},
+        {"فارسی (افغانستان)", "Persian (Afghanistan)", "FA", "af"},
+        {"Polski", "Polish", "PL", "pl"},
+        {"Português (Angola)", "Portuguese (Angola)", "PT", "ao"},
+        {"Português (Brasil)", "Portuguese (Brazil)", "PT", "br"},
+        {"Português (Moçambique)", "Portuguese (Mozambique)", "PT", "mz"},
+        {"ਪੰਜਾਬੀ", "Punjabi", "PA", "in"},
+        {"Runasimi", "Quechua", "QU", "pe"},
+        {"Română", "Romanian", "RO", "ro"},
+        {"Română (Moldova)", "Romanian (Moldova)", "RO", "md"},
+        {"Rumantsch", "Romansh", "RM", "ch"},
+        {"Русский (Беларусь)", "Russian (Belarus)", "RU", "by"},
+        {"Русский (Казахстан)", "Russian (Kazakhstan)", "RU", "kz"},
+        {"Gagana Sāmoa", "Samoan", "SM", "ws"},
+        {"Sängö", "Sango", "SG", "cf"},
+        {"Sardu", "Sardinian", "SC", "it"},
+        {"Gàidhlig", "Scottish Gaelic", "GD", "gb-sct"},
+        {"Српски", "Serbian", "SR", "rs"},
+        {"Sesotho", "Sesotho", "ST", "ls"},
+        {"Setswana", "Setswana", "TN", "bw"},
+        {"chiShona", "Shona", "SN", "zw"},
+        {"සිංහල", "Sinhala", "SI", "lk"},
+        {"Slovenčina", "Slovak", "SK", "sk"},
+        {"Slovenščina", "Slovenian", "SL", "si"},
+        {"Soomaali", "Somali", "SO", "so"},
+        {"Español (Argentina)", "Spanish (Argentina)", "ES", "ar"},
+        {"Español (Bolivia)", "Spanish (Bolivia)", "ES", "bo"},
+        {"Español (Chile)", "Spanish (Chile)", "ES", "cl"},
+        {"Español (Colombia)", "Spanish (Colombia)", "ES", "co"},
+        {"Español (Costa Rica)", "Spanish (Costa Rica)", "ES", "cr"},
+        {"Español (Cuba)", "Spanish (Cuba)", "ES", "cu"},
+        {"Español (República Dominicana)", "Spanish (Dominican Republic)", "ES", "do"},
+        {"Español (Ecuador)", "Spanish (Ecuador)", "ES", "ec"},
+        {"Español (El Salvador)", "Spanish (El Salvador)", "ES", "sv"},
+        {"Español (Guatemala)", "Spanish (Guatemala)", "ES", "gt"},
+        {"Español (Honduras)", "Spanish (Honduras)", "ES", "hn"},
+        {"Español (México)", "Spanish (Mexico)", "ES", "mx"},
+        {"Español (Nicaragua)", "Spanish (Nicaragua)", "ES", "ni"},
+        {"Español (Panamá)", "Spanish (Panama)", "ES", "pa"},
+        {"Español (Paraguay)", "Spanish (Paraguay)", "ES", "py"},
+        {"Español (Perú)", "Spanish (Peru)", "ES", "pe"},
+        {"Español (Puerto Rico)", "Spanish (Puerto Rico)", "ES", "pr"},
+        {"Español (Estados Unidos)", "Spanish (United States)", "ES", "us"},
+        {"Español (Uruguay)", "Spanish (Uruguay)", "ES", "uy"},
+        {"Español (Venezuela)", "Spanish (Venezuela)", "ES", "ve"},
+        {"Kiswahili", "Swahili", "SW", "tz"},
+        {"Kiswahili (Kenya)", "Swahili (Kenya)", "SW", "ke"},
+        {"SiSwati", "Swati", "SS", "sz"},
+        {"Svenska", "Swedish", "SV", "se"},
+        {"Svenska (Finland)", "Swedish (Finland)", "SV", "fi"},
+        {"Тоҷикӣ", "Tajik", "TG", "tj"},
+        {"தமிழ்", "Tamil", "TA", "in"},
+        {"தமிழ் (இலங்கை)", "Tamil (Sri Lanka)", "TA", "lk"},
+        {"Татар", "Tatar", "TT", "ru"},
+        {"తెలుగు", "Telugu", "TE", "in"},
+        {"ไทย", "Thai", "TH", "th"},
+        {"ትግርኛ", "Tigrinya", "TI", "er"},
+        {"Lea fakatonga", "Tongan", "TO", "to"},
+        {"Türkçe", "Turkish", "TR", "tr"},
+        {"Türkmen", "Turkmen", "TK", "tm"},
+        {"Українська", "Ukrainian", "UK", "ua"},
+        {"اردو", "Urdu", "UR", "pk"},
+        {"O‘zbek", "Uzbek", "UZ", "uz"},
+        {"Tiếng Việt", "Vietnamese", "VI", "vn"},
+        {"Cymraeg", "Welsh", "CY", "gb-wls"},
+        {"Wolof", "Wolof", "WO", "sn"},
+        {"isiXhosa", "Xhosa", "XH", "za"},
+        {"Yorùbá", "Yoruba", "YO", "ng"},
+        {"isiZulu", "Zulu", "ZU", "za"}
+    };
+    return locales;
+}
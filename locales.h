@@ -0,0 +1,25 @@
+#ifndef LOCALES_H
+#define LOCALES_H
+
+#include <QList>
+#include <QString>
+
+// Locale - One entry of the language selector
+struct Locale
+{
+    QString nativeName;     // shown in the list and on the button
+    QString englishName;    // searchable, not shown
+    QString code;           // translation key, e.g. "EN"
+    QString countryCode;    // circle-flags name, e.g. "gb" or "es-ct"
+};
+
+// Locales - Every locale PandaBlur ships to
+//
+// The twelve featured languages come first in their historical order; the
+// rest follow sorted by English name. Regional variants share the code of
+// their language, so they use the same translations.
+namespace Locales {
+    const QList<Locale> &all();
+}
+
+#endif // LOCALES_H
@@ -1,8 +1,17 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QTimer>
 #include <QStyleFactory>
 #include <QPalette>
 #include <QFont>
 #include "mainwindow.h"
+#include "networkservice.h"
+#include "paintstats.h"
+#include "polishstats.h"
+#include "renderquality.h"
+#include "theme.h"
+#include "config.h"
 
 int main(int argc, char *argv[])
 {
@@ -13,12 +22,43 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("1.0.0");
     app.setOrganizationName("PandaBlur Security");
 
+    // PANDABLUR_PAINT_STATS=1 logs the pixels each update repaints
+    PaintStats::instance().install();
+
+    // One style sheet for every widget, set before any widget exists
+    PolishStats::instance().install();
+    app.setStyleSheet(ResourceManager::instance().getStyleSheet("app"));
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOption({"quality",
+                      "Rendering quality: full, reduced, minimal or auto (measured at startup). "
+                      "Overrides PANDABLUR_QUALITY.", "tier"});
+    parser.process(app);
+
+    if (parser.isSet("quality") && !RenderQuality::instance().setOverride(parser.value("quality"))) {
+        qWarning() << "Ignoring unknown --quality:" << parser.value("quality");
+    }
+
+    // Warm up the TLS connections while the window is being built
+    NetworkService::instance().preconnect({QUrl(Config::FLAGS_REMOTE_URL), QUrl(Config::GEOLOCATION_URL)});
+
     // Set modern font
     QFont font("Segoe UI", 10);
     app.setFont(font);
 
+    // Light or dark as the platform says, before the first paint and on every change
+    Theme::instance().setFollowSystem(true);
+
     MainWindow window;
     window.show();
 
+    // Times a few repaints of the real window and lowers the tier on slow renderers
+    RenderQuality::instance().startProbe(&window);
+
+    // Everything shown so far has been polished by now
+    QTimer::singleShot(0, &PolishStats::instance(), &PolishStats::finishStartup);
+
     return app.exec();
 }
@@ -1,23 +1,43 @@
 #include "mainwindow.h"
+#include "flagloader.h"
+#include "flagdiskcache.h"
+#include "flagrastercache.h"
+#include "flagatlas.h"
+#include "networkservice.h"
+#include "svgassetregistry.h"
+#include "assetpack.h"
+#include "dropshadow.h"
+#include "blurengine.h"
+#include "paintcache.h"
+#include "renderquality.h"
+#include "theme.h"
+#include "locales.h"
+#include "iconpainter.h"
+#include "generatedicons.h"
+#include "appstylesheet.h"
 #include <QApplication>
 #include <QScreen>
 #include <QMessageBox>
-#include <QGraphicsDropShadowEffect>
 #include <QMouseEvent>
 #include <QEnterEvent>
+#include <QWindow>
+#include <QShowEvent>
 #include <QDebug>
 #include <QEasingCurve>
-#include <QNetworkRequest>
 #include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QStandardPaths>
 #include <QDir>
 #include <QCryptographicHash>
 #include <algorithm>
+#include <cmath>
 #include <QPainter>
 #include <QPen>
 #include <QPainterPath>
 #include <QBrush>
 #include <QPixmap>
+#include <QImage>
 #include <QColor>
 #include <QFont>
 #include <QRect>
@@ -26,75 +46,48 @@
 #include <QSize>
 #include <QUrl>
 #include <QLabel>
-
-// Static cache initialization
-QHash<QString, QPixmap> CrispCircleFlagWidget::s_flagCache;
+#include <QScrollBar>
+#include <QStyle>
 
 // CrispSvgWidget - Optimized SVG rendering with proper aspect ratio
 CrispSvgWidget::CrispSvgWidget(const QString &file, QWidget *parent)
     : QWidget(parent)
-    , m_svgRenderer(std::make_unique<QSvgRenderer>(this))
+    , m_assetName(file)
+    , m_hasAsset(!file.isEmpty() && SvgAssetRegistry::instance().hasAsset(file))
 {
-    setStyleSheet("background: transparent;");
     setAttribute(Qt::WA_OpaquePaintEvent, false);
     setAttribute(Qt::WA_NoSystemBackground, true);
 
-    // Try different paths to find your SVG
-    if (!file.isEmpty()) {
-        QStringList paths = {
-            file,                                           // Direct path
-            QApplication::applicationDirPath() + "/" + file, // App directory
-            QDir::currentPath() + "/" + file,               // Current directory
-            ":/" + file                                     // Resource path
-        };
-
-        for (const QString& path : paths) {
-            if (QFile::exists(path)) {
-                m_svgRenderer->load(path);
-                if (m_svgRenderer->isValid()) {
-                    qDebug() << "Successfully loaded SVG from:" << path;
-                    break;
-                }
-            }
-        }
+    connect(&SvgAssetRegistry::instance(), &SvgAssetRegistry::assetChanged, this, &CrispSvgWidget::onAssetChanged);
+}
 
-        if (!m_svgRenderer->isValid()) {
-            qDebug() << "Failed to load SVG from any path. Tried:" << paths;
-        }
-    }
+void CrispSvgWidget::onAssetChanged(const QString &name)
+{
+    if (name != m_assetName) return;
+    m_cachedPixmap = QPixmap();
+    update();
+}
+
+void CrispSvgWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_cachedPixmap = QPixmap();
 }
 
 void CrispSvgWidget::paintEvent(QPaintEvent *event)
 {
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
-
-    if (m_svgRenderer && m_svgRenderer->isValid()) {
-        // Get the SVG's natural size
-        QSize svgSize = m_svgRenderer->defaultSize();
-        QRect targetRect = rect();
-
-        // Calculate scaling to fit while maintaining aspect ratio
-        if (svgSize.isValid()) {
-            double scaleX = (double)targetRect.width() / svgSize.width();
-            double scaleY = (double)targetRect.height() / svgSize.height();
-            double scale = std::min(scaleX, scaleY);
-
-            // Calculate centered position
-            int scaledWidth = (int)(svgSize.width() * scale);
-            int scaledHeight = (int)(svgSize.height() * scale);
-            int x = (targetRect.width() - scaledWidth) / 2;
-            int y = (targetRect.height() - scaledHeight) / 2;
-
-            QRect centeredRect(x, y, scaledWidth, scaledHeight);
-            m_svgRenderer->render(&painter, centeredRect);
-        } else {
-            // Fallback to full rect if no natural size
-            m_svgRenderer->render(&painter, targetRect);
+
+    if (m_hasAsset) {
+        // DPR is checked here rather than tracked so a screen change costs one re-render
+        const qreal dpr = devicePixelRatioF();
+        if (m_cachedPixmap.isNull() || !qFuzzyCompare(m_cachedPixmap.devicePixelRatio(), dpr)) {
+            m_cachedPixmap = SvgAssetRegistry::instance().raster(m_assetName, size(), dpr);
         }
+        painter.drawPixmap(0, 0, m_cachedPixmap);
     } else {
         // Fallback placeholder
+        painter.setRenderHint(QPainter::Antialiasing, true);
         painter.setBrush(QColor(240, 240, 240));
         painter.setPen(QPen(QColor(200, 200, 200), 2));
         painter.drawRoundedRect(rect().adjusted(10, 10, -10, -10), 20, 20);
@@ -115,32 +108,8 @@ SimpleButton::SimpleButton(const QString &text, QWidget *parent)
     setCursor(Qt::PointingHandCursor);
     setObjectName("continueButton");
 
-    // Fallback styling since ResourceManager might not be available
-    setStyleSheet(
-        "QPushButton#continueButton {"
-        "    background-color: #000000;"
-        "    color: white;"
-        "    font-size: 22px;"
-        "    font-weight: 600;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "    border: none;"
-        "    border-radius: 30px;"
-        "    padding: 15px 30px;"
-        "}"
-        "QPushButton#continueButton:hover {"
-        "    background-color: #333333;"
-        "}"
-        "QPushButton#continueButton:pressed {"
-        "    background-color: #1a1a1a;"
-        "}"
-        );
-
-    // Add shadow effect
-    auto* shadow = new QGraphicsDropShadowEffect(this);
-    shadow->setBlurRadius(18);
-    shadow->setColor(QColor(0, 0, 0, 30));
-    shadow->setOffset(0, 4);
-    setGraphicsEffect(shadow);
+    // Cached nine-patch shadow; follows the button into whatever layout it ends up in
+    DropShadowWidget::attach(this, ShadowSpec{30, 18, QColor(0, 0, 0, 30), QPoint(0, 4)});
 }
 
 void SimpleButton::updateText(const QString &text)
@@ -152,60 +121,56 @@ void SimpleButton::updateText(const QString &text)
 WindowControlButton::WindowControlButton(const QString &svgPath, QWidget *parent)
     : QPushButton(parent)
     , m_filePath(svgPath)
+    , m_hasIcon(SvgAssetRegistry::instance().hasAsset(svgPath))
     , m_isHovered(false)
 {
     setFixedSize(32, 32);
     setCursor(Qt::PointingHandCursor);
-    setStyleSheet("background: transparent; border: none;");
-
-    // Try multiple paths for SVG loading
-    QStringList paths = {
-        QApplication::applicationDirPath() + "/" + svgPath,
-        svgPath,
-        ":/" + svgPath
-    };
-
-    for (const QString& path : paths) {
-        m_svgRenderer.reset(new QSvgRenderer(path, this));
-        if (m_svgRenderer->isValid()) {
-            break;
-        }
-    }
 
     setAttribute(Qt::WA_OpaquePaintEvent, false);
 }
 
 void WindowControlButton::paintEvent(QPaintEvent *event)
 {
+    Q_UNUSED(event);
+
+    const QString key = QString("window-control/%1/%2").arg(m_filePath, m_isHovered ? "hover" : "normal");
+    const bool hovered = m_isHovered;
+    const QPixmap state = PaintCache::instance().state(key, size(), devicePixelRatioF(),
+        [this, hovered](QPainter *painter, const QSize &size) {
+            paintState(painter, QRect(QPoint(0, 0), size), hovered);
+        });
+
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.drawPixmap(0, 0, state);
+}
 
-    QRect circleRect = rect().adjusted(2, 2, -2, -2);
-    QColor backgroundColor = m_isHovered ?
+void WindowControlButton::paintState(QPainter *painter, const QRect &bounds, bool hovered) const
+{
+    QRect circleRect = bounds.adjusted(2, 2, -2, -2);
+    QColor backgroundColor = hovered ?
                                  QColor(120, 120, 120, 180) : QColor(80, 80, 80, 150);
 
-    painter.setBrush(backgroundColor);
-    painter.setPen(Qt::NoPen);
-    painter.drawEllipse(circleRect);
+    painter->setBrush(backgroundColor);
+    painter->setPen(Qt::NoPen);
+    painter->drawEllipse(circleRect);
 
-    if (m_svgRenderer && m_svgRenderer->isValid()) {
-        QRect iconRect = rect().adjusted(10, 10, -10, -10);
-        m_svgRenderer->render(&painter, iconRect);
+    if (m_hasIcon) {
+        QRect iconRect = bounds.adjusted(10, 10, -10, -10);
+        SvgAssetRegistry::instance().paint(painter, m_filePath, iconRect);
     } else {
         // Fallback drawing
-        painter.setPen(QPen(Qt::white, 2));
-        QRect iconRect = rect().adjusted(10, 10, -10, -10);
+        painter->setPen(QPen(Qt::white, 2));
+        QRect iconRect = bounds.adjusted(10, 10, -10, -10);
 
         if (m_filePath.contains("minimize")) {
             int centerY = iconRect.center().y();
-            painter.drawLine(iconRect.left(), centerY, iconRect.right(), centerY);
+            painter->drawLine(iconRect.left(), centerY, iconRect.right(), centerY);
         } else if (m_filePath.contains("close")) {
-            painter.drawLine(iconRect.topLeft(), iconRect.bottomRight());
-            painter.drawLine(iconRect.topRight(), iconRect.bottomLeft());
+            painter->drawLine(iconRect.topLeft(), iconRect.bottomRight());
+            painter->drawLine(iconRect.topRight(), iconRect.bottomLeft());
         }
     }
-
-    QPushButton::paintEvent(event);
 }
 
 void WindowControlButton::enterEvent(QEnterEvent *event)
@@ -226,18 +191,12 @@ void WindowControlButton::leaveEvent(QEvent *event)
 AnimatedArrowWidget::AnimatedArrowWidget(QWidget *parent)
     : QWidget(parent)
     , m_rotation(0)
+    , m_frame(0)
 {
     setFixedSize(24, 24);
 
-    QString arrowSvg =
-        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"24\" height=\"24\" fill=\"none\" viewBox=\"0 0 24 24\">"
-        "<path stroke=\"#8c8c8c\" stroke-linecap=\"round\" stroke-linejoin=\"round\" stroke-width=\"2\" d=\"m19 9-7 7-7-7\"/>"
-        "</svg>";
-
-    m_arrowRenderer.reset(new QSvgRenderer(arrowSvg.toUtf8(), this));
-
     m_rotationAnimation.reset(new QPropertyAnimation(this, "rotation", this));
-    m_rotationAnimation->setDuration(250);
+    m_rotationAnimation->setDuration(Config::ARROW_ANIMATION_MS);
     m_rotationAnimation->setEasingCurve(QEasingCurve::OutCubic);
 }
 
@@ -246,46 +205,77 @@ void AnimatedArrowWidget::setRotation(qreal rotation)
     if (qFuzzyCompare(m_rotation, rotation)) return;
 
     m_rotation = rotation;
+
+    // Ticks that land on the frame already shown cost nothing
+    const int frame = frameFor(rotation);
+    if (frame == m_frame) return;
+    m_frame = frame;
     update();
 }
 
+int AnimatedArrowWidget::frameFor(qreal rotation)
+{
+    constexpr qreal step = 360.0 / Config::ARROW_ROTATION_FRAMES;
+    const qreal turn = std::fmod(std::fmod(rotation, 360.0) + 360.0, 360.0);
+    return qRound(turn / step) % Config::ARROW_ROTATION_FRAMES;
+}
+
 void AnimatedArrowWidget::animateToUp()
 {
-    m_rotationAnimation->setStartValue(m_rotation);
-    m_rotationAnimation->setEndValue(180.0);
-    m_rotationAnimation->start();
+    animateTo(180.0);
 }
 
 void AnimatedArrowWidget::animateToDown()
 {
+    animateTo(0.0);
+}
+
+void AnimatedArrowWidget::animateTo(qreal rotation)
+{
+    // The minimal quality tier jumps straight to the end frame
+    const int duration = RenderQuality::instance().animationDuration(Config::ARROW_ANIMATION_MS);
+    m_rotationAnimation->stop();
+    if (duration <= 0) {
+        setRotation(rotation);
+        return;
+    }
+
+    m_rotationAnimation->setDuration(duration);
     m_rotationAnimation->setStartValue(m_rotation);
-    m_rotationAnimation->setEndValue(0.0);
+    m_rotationAnimation->setEndValue(rotation);
     m_rotationAnimation->start();
 }
 
 void AnimatedArrowWidget::paintEvent(QPaintEvent *event)
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
-
-    painter.translate(width() / 2.0, height() / 2.0);
-    painter.rotate(m_rotation);
-    painter.translate(-width() / 2.0, -height() / 2.0);
-
-    if (m_arrowRenderer && m_arrowRenderer->isValid()) {
-        m_arrowRenderer->render(&painter, rect());
-    }
+    Q_UNUSED(event);
+
+    // arrow.svg compiled by svg2cpp, one rotated copy per frame side by side
+    constexpr int frames = Config::ARROW_ROTATION_FRAMES;
+    const qreal dpr = devicePixelRatioF();
+    const QPixmap strip = PaintCache::instance().state("arrow/rotation", QSize(width() * frames, height()), dpr,
+        [](QPainter *painter, const QSize &size) {
+            const qreal frameWidth = qreal(size.width()) / frames;
+            for (int frame = 0; frame < frames; ++frame) {
+                painter->save();
+                painter->translate(frame * frameWidth + frameWidth / 2.0, size.height() / 2.0);
+                painter->rotate(frame * 360.0 / frames);
+                painter->translate(-frameWidth / 2.0, -size.height() / 2.0);
+                IconPainter::paint(painter, GeneratedIcons::ARROW, QRectF(0, 0, frameWidth, size.height()));
+                painter->restore();
+            }
+        });
 
-    QWidget::paintEvent(event);
+    const QRectF source(m_frame * width() * dpr, 0, width() * dpr, height() * dpr);
+    QPainter painter(this);
+    painter.drawPixmap(QRectF(rect()), strip, source);
 }
 
-// CrispCircleFlagWidget - Optimized with caching and timeouts
+// CrispCircleFlagWidget - Optimized with caching; bundled flags are read from resources,
+// everything else is downloaded through FlagLoader and rasterized off the GUI thread
 CrispCircleFlagWidget::CrispCircleFlagWidget(const QString &flagUrl, QWidget *parent)
     : QWidget(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-    , m_timeoutTimer(new QTimer(this))
-    , m_currentReply(nullptr)
+    , m_fetchPriority(FlagLoader::Priority::Offscreen)
     , m_isLoading(false)
     , m_pixmapCached(false)
 {
@@ -293,117 +283,282 @@ CrispCircleFlagWidget::CrispCircleFlagWidget(const QString &flagUrl, QWidget *pa
     setAttribute(Qt::WA_OpaquePaintEvent, false);
     setAttribute(Qt::WA_NoSystemBackground, true);
 
-    m_timeoutTimer->setSingleShot(true);
-    m_timeoutTimer->setInterval(Config::NETWORK_TIMEOUT_MS);
-    connect(m_timeoutTimer.get(), &QTimer::timeout, this, &CrispCircleFlagWidget::onNetworkTimeout);
+    FlagLoader& loader = FlagLoader::instance();
+    connect(&loader, &FlagLoader::flagLoaded, this, &CrispCircleFlagWidget::onFlagLoaded);
+    connect(&loader, &FlagLoader::flagFailed, this, &CrispCircleFlagWidget::onFlagFailed);
+    connect(&loader, &FlagLoader::flagInvalidated, this, &CrispCircleFlagWidget::onFlagInvalidated);
+    connect(&FlagRasterCache::instance(), &FlagRasterCache::rasterReady,
+            this, &CrispCircleFlagWidget::onRasterReady);
 
     setFlag(flagUrl);
 }
 
+CrispCircleFlagWidget::~CrispCircleFlagWidget()
+{
+    cancelPendingRaster();
+}
+
 int CrispCircleFlagWidget::calculateOptimalScale() const
 {
-    qreal devicePixelRatio = devicePixelRatioF();
-    int scale = static_cast<int>(std::clamp(devicePixelRatio * 2,
-                                            static_cast<qreal>(Config::MIN_RENDER_SCALE),
-                                            static_cast<qreal>(Config::MAX_RENDER_SCALE)));
-    return scale;
+    // Supersampling depends on the quality tier
+    return RenderQuality::instance().flagRenderScale(devicePixelRatioF());
+}
+
+FlagRasterKey CrispCircleFlagWidget::rasterKey() const
+{
+    return FlagRasterKey{m_currentFlagUrl, size(), devicePixelRatioF()};
 }
 
 void CrispCircleFlagWidget::setFlag(const QString &flagUrl)
 {
     if (m_currentFlagUrl == flagUrl) return;
 
+    cancelPendingRaster();
+
     m_currentFlagUrl = flagUrl;
+    m_svgData.clear();
+    m_contentHash.clear();
+    m_atlasRect = QRect();
+
+    m_pixmapCached = false;
+
+    // Packed flags are a sub-rect of the shared atlas pixmap
+    if (useAtlas()) {
+        m_isLoading = false;
+        update();
+        return;
+    }
 
     // Check cache first
-    if (s_flagCache.contains(flagUrl)) {
-        m_cachedPixmap = s_flagCache[flagUrl];
-        m_pixmapCached = true;
+    if (useCachedRaster()) {
         m_isLoading = false;
         update();
         return;
     }
 
-    if (flagUrl.isEmpty()) return;
+    // Compiled-in flags skip the network and never show the loading state
+    if (FlagResolver::isLocalSource(flagUrl)) {
+        m_isLoading = false;
+        m_svgData = loadSvgData();
+        if (!m_svgData.isEmpty()) {
+            renderFlag();
+        } else {
+            qDebug() << "Failed to load bundled flag:" << flagUrl;
+            update();
+        }
+        return;
+    }
 
-    // Cancel previous request
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply = nullptr;
+    // Warm start: serve from the persistent cache and refresh in the background
+    if (loadFromDiskCache(flagUrl)) {
+        m_isLoading = false;
+        FlagLoader::instance().revalidateFlag(flagUrl);
+        update();
+        return;
     }
 
-    m_isLoading = true;
-    m_pixmapCached = false;
+    m_isLoading = !flagUrl.isEmpty() && FlagLoader::instance().requestFlag(flagUrl, m_fetchPriority);
+    update();
+}
 
-    QUrl url(flagUrl);
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader, "PandaBlur/1.0");
-    request.setRawHeader("Accept", "image/svg+xml,image/*");
+void CrispCircleFlagWidget::setFetchPriority(FlagLoader::Priority priority)
+{
+    if (m_fetchPriority == priority) return;
 
-    m_currentReply = m_networkManager->get(request);
-    m_timeoutTimer->start();
+    m_fetchPriority = priority;
+    if (m_isLoading) {
+        FlagLoader::instance().setPriority(m_currentFlagUrl, priority);
+    }
+}
 
-    connect(m_currentReply, &QNetworkReply::finished, this, &CrispCircleFlagWidget::onFlagDownloaded);
+bool CrispCircleFlagWidget::isAtlasFlag() const
+{
+    return FlagResolver::isLocalSource(m_currentFlagUrl)
+           && FlagAtlas::instance().contains(FlagResolver::countryCode(m_currentFlagUrl));
 }
 
-void CrispCircleFlagWidget::onNetworkTimeout()
+bool CrispCircleFlagWidget::useAtlas()
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply = nullptr;
+    m_atlasRect = QRect();
+    if (!isAtlasFlag()) return false;
+
+    FlagAtlas& atlas = FlagAtlas::instance();
+    const qreal dpr = devicePixelRatioF();
+    const int scale = atlas.scaleFor(dpr);
+    const QRect source = atlas.sourceRect(FlagResolver::countryCode(m_currentFlagUrl), scale);
+    if (source.isNull()) return false;
+
+    // Integer ratios match a packed cell exactly and are blitted straight from the atlas
+    if (qFuzzyCompare(dpr, static_cast<qreal>(scale))) {
+        m_atlasRect = source;
+        return true;
     }
 
+    // Fractional ratios: resample the cell once to exact device pixels
+    if (!useCachedRaster()) {
+        m_cachedPixmap = FlagRasterCache::fitToDevicePixels(atlas.pixmap().copy(source), size(), dpr);
+        FlagRasterCache::instance().insert(rasterKey(), m_cachedPixmap);
+        m_pixmapCached = !m_cachedPixmap.isNull();
+    }
+    return m_pixmapCached;
+}
+
+bool CrispCircleFlagWidget::useCachedRaster()
+{
+    QPixmap pixmap = FlagRasterCache::instance().find(rasterKey());
+    if (pixmap.isNull()) return false;
+
+    m_cachedPixmap = pixmap;
+    m_pixmapCached = true;
+    return true;
+}
+
+QByteArray CrispCircleFlagWidget::loadSvgData() const
+{
+    if (!m_svgData.isEmpty()) return m_svgData;
+
+    // A view into the mapped pack, not a copy
+    if (FlagResolver::isLocalSource(m_currentFlagUrl)) {
+        return AssetPack::instance().data(FlagResolver::assetName(m_currentFlagUrl));
+    }
+
+    FlagDiskCache::Entry entry;
+    if (FlagDiskCache::instance().lookup(m_currentFlagUrl, &entry)) {
+        return FlagDiskCache::instance().svgData(entry.contentHash);
+    }
+    return QByteArray();
+}
+
+bool CrispCircleFlagWidget::loadFromDiskCache(const QString &flagUrl)
+{
+    FlagDiskCache& diskCache = FlagDiskCache::instance();
+    FlagDiskCache::Entry entry;
+    if (flagUrl.isEmpty() || !diskCache.lookup(flagUrl, &entry)) return false;
+
+    m_contentHash = entry.contentHash;
+
+    // Prefer the pre-rasterized pixmap so no SVG parsing happens on startup
+    const qreal dpr = devicePixelRatioF();
+    QPixmap pixmap = diskCache.loadRaster(m_contentHash, FlagRasterCache::devicePixelSize(size(), dpr));
+    if (!pixmap.isNull()) {
+        pixmap.setDevicePixelRatio(dpr);
+        m_cachedPixmap = pixmap;
+        FlagRasterCache::instance().insert(rasterKey(), m_cachedPixmap);
+        m_pixmapCached = true;
+        return true;
+    }
+
+    m_svgData = diskCache.svgData(m_contentHash);
+    if (m_svgData.isEmpty()) return false;
+
+    renderFlag();
+    return true;
+}
+
+void CrispCircleFlagWidget::onFlagFailed(const QString &flagUrl)
+{
+    if (flagUrl != m_currentFlagUrl) return;
+
     m_isLoading = false;
     update();
+}
 
-    qDebug() << "Flag download timeout for:" << m_currentFlagUrl;
+void CrispCircleFlagWidget::onFlagInvalidated(const QString &flagUrl)
+{
+    FlagRasterCache::instance().removeSource(flagUrl);
 }
 
-void CrispCircleFlagWidget::onFlagDownloaded()
+void CrispCircleFlagWidget::onFlagLoaded(const QString &flagUrl, const QByteArray &svgData)
 {
-    m_timeoutTimer->stop();
+    if (flagUrl != m_currentFlagUrl) return;
 
-    if (!m_currentReply) return;
+    m_isLoading = false;
+    m_svgData = svgData;
+    m_contentHash = FlagDiskCache::contentHash(svgData);
 
-    if (m_currentReply->error() == QNetworkReply::NoError) {
-        QByteArray svgData = m_currentReply->readAll();
+    // Another subscriber may already have rendered this flag
+    if (useCachedRaster()) {
+        update();
+        return;
+    }
 
-        if (!svgData.isEmpty()) {
-            m_svgRenderer.reset(new QSvgRenderer(svgData, this));
+    renderFlag();
+}
 
-            if (m_svgRenderer->isValid()) {
-                renderFlag();
-            }
+void CrispCircleFlagWidget::renderFlag()
+{
+    // Parsing and rasterizing happen on the thread pool; onRasterReady picks up the result
+    cancelPendingRaster();
+
+    m_pendingKey = rasterKey();
+    FlagRasterCache::instance().rasterizeAsync(m_pendingKey, m_svgData,
+                                               calculateOptimalScale(), m_contentHash);
+    update();
+}
+
+void CrispCircleFlagWidget::cancelPendingRaster()
+{
+    if (m_pendingKey.source.isEmpty()) return;
+
+    FlagRasterCache::instance().cancel(m_pendingKey);
+    m_pendingKey = FlagRasterKey();
+}
+
+void CrispCircleFlagWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    QWindow *window = this->window()->windowHandle();
+    if (window && window != m_trackedWindow) {
+        if (m_trackedWindow) {
+            disconnect(m_trackedWindow, &QWindow::screenChanged, this, &CrispCircleFlagWidget::onScreenChanged);
         }
-    } else {
-        qDebug() << "Flag download failed:" << m_currentReply->errorString();
+        m_trackedWindow = window;
+        connect(window, &QWindow::screenChanged, this, &CrispCircleFlagWidget::onScreenChanged);
     }
 
-    m_currentReply->deleteLater();
-    m_currentReply = nullptr;
-    m_isLoading = false;
+    // The screen may have changed while this flag was hidden
+    if (isAtlasFlag()) {
+        useAtlas();
+    } else if (m_pixmapCached && !qFuzzyCompare(m_cachedPixmap.devicePixelRatio(), devicePixelRatioF())) {
+        onScreenChanged();
+    }
 }
 
-void CrispCircleFlagWidget::renderFlag()
+void CrispCircleFlagWidget::onScreenChanged()
 {
-    if (!m_svgRenderer || !m_svgRenderer->isValid()) return;
+    if (isAtlasFlag()) {
+        useAtlas();
+        update();
+        return;
+    }
 
-    int scale = calculateOptimalScale();
-    QSize renderSize = size() * scale;
+    if (!m_pixmapCached || m_currentFlagUrl.isEmpty()) return;
 
-    m_cachedPixmap = QPixmap(renderSize);
-    m_cachedPixmap.fill(Qt::transparent);
+    // Hidden flags are refreshed from showEvent when they become visible again
+    if (!isVisible()) return;
 
-    QPainter painter(&m_cachedPixmap);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    if (useCachedRaster()) {
+        update();
+        return;
+    }
+
+    // Keep painting the old-resolution pixmap until the new one is ready
+    m_svgData = loadSvgData();
+    renderFlag();
+}
 
-    m_svgRenderer->render(&painter, QRect(0, 0, renderSize.width(), renderSize.height()));
+void CrispCircleFlagWidget::onRasterReady(const FlagRasterKey &key, const QPixmap &pixmap)
+{
+    if (key != rasterKey()) return;
 
-    // Cache the result
-    s_flagCache[m_currentFlagUrl] = m_cachedPixmap;
-    m_pixmapCached = true;
+    if (key == m_pendingKey) {
+        m_pendingKey = FlagRasterKey();
+    }
 
+    m_cachedPixmap = pixmap;
+    m_pixmapCached = true;
+    m_isLoading = false;
     update();
 }
 
@@ -411,10 +566,12 @@ void CrispCircleFlagWidget::paintEvent(QPaintEvent *event)
 {
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
 
-    if (m_pixmapCached && !m_cachedPixmap.isNull()) {
-        painter.drawPixmap(rect(), m_cachedPixmap);
+    // Both paths are 1:1 device-pixel blits; no smooth transform on paint
+    if (!m_atlasRect.isNull()) {
+        painter.drawPixmap(rect(), FlagAtlas::instance().pixmap(), m_atlasRect);
+    } else if (m_pixmapCached && !m_cachedPixmap.isNull()) {
+        painter.drawPixmap(0, 0, m_cachedPixmap);
     } else if (m_isLoading) {
         // Loading indicator
         painter.setBrush(QColor(245, 245, 245, 200));
@@ -441,11 +598,18 @@ ResourceManager& ResourceManager::instance()
 ResourceManager::ResourceManager(QObject *parent)
     : QObject(parent)
 {
-    // Simplified for now - no resource loading to avoid dependency issues
 }
 
 QString ResourceManager::getTranslation(const QString &key, const QString &language)
 {
+    // translations.json from the asset pack wins; the table below covers a missing pack
+    static const QJsonObject packed = QJsonDocument::fromJson(
+        AssetPack::instance().data(Config::TRANSLATIONS_ASSETS + "translations.json")).object();
+    const QJsonValue packedValue = packed.value(language).toObject().value(key);
+    if (packedValue.isString()) {
+        return packedValue.toString();
+    }
+
     // Hardcoded translations as fallback
     static const QMap<QString, QMap<QString, QString>> translations = {
         {"EN", {
@@ -527,127 +691,55 @@ QPixmap ResourceManager::getFlagPixmap(const QString &countryCode)
 
 QString ResourceManager::getStyleSheet(const QString &name)
 {
-    // Fallback styles with THINNER scroll bar
-    if (name == "dropdown") {
-        return
-            "QListWidget {"
-            "    background-color: rgba(255, 255, 255, 0.98);"
-            "    border: 1px solid #d0d0d0;"
-            "    border-radius: 16px;"
-            "    font-family: 'Segoe UI', Arial, sans-serif;"
-            "    font-size: 15px;"
-            "    outline: none;"
-            "    padding: 5px;"
-            "}"
-            "QListWidget::item {"
-            "    background-color: transparent;"
-            "    color: #1a1a1a;"
-            "    border-radius: 8px;"
-            "    margin: 1px 2px;"
-            "    min-height: 50px;"
-            "}"
-            "QListWidget::item:hover {"
-            "    background-color: rgba(240, 240, 240, 0.9);"
-            "}"
-            "QScrollBar:vertical {"
-            "    background: rgba(248, 248, 248, 0.4);"
-            "    width: 6px;"  // MADE THINNER - REDUCED FROM 10px TO 6px
-            "    border-radius: 3px;"  // ADJUSTED RADIUS TO MATCH NEW WIDTH
-            "}"
-            "QScrollBar::handle:vertical {"
-            "    background: rgba(180, 180, 180, 0.8);"
-            "    border-radius: 3px;"  // ADJUSTED RADIUS TO MATCH NEW WIDTH
-            "    min-height: 28px;"
-            "}"
-            "QScrollBar::handle:vertical:hover {"
-            "    background: rgba(140, 140, 140, 0.9);"
-            "}"
-            "QScrollBar::add-line:vertical {"
-            "    height: 0px;"
-            "    subcontrol-position: bottom;"
-            "    subcontrol-origin: margin;"
-            "}"
-            "QScrollBar::sub-line:vertical {"
-            "    height: 0px;"
-            "    subcontrol-position: top;"
-            "    subcontrol-origin: margin;"
-            "}"
-            "QScrollBar::up-arrow:vertical, QScrollBar::down-arrow:vertical {"
-            "    width: 0px;"
-            "    height: 0px;"
-            "    background: none;"
-            "}"
-            "QScrollBar::add-page:vertical, QScrollBar::sub-page:vertical {"
-            "    background: none;"
-            "}";
+    const QByteArray packed = AssetPack::instance().data(Config::STYLES_ASSETS + name + ".qss");
+    if (!packed.isEmpty()) {
+        return QString::fromUtf8(packed);
+    }
+
+    // Compiled in from styles/app.qss for a missing or stale pack
+    if (name == "app") {
+        return QString::fromUtf8(AppStyleSheet::SOURCE);
     }
     return QString();
 }
 
-// GeolocationService - Optimized with timeout and error handling
+// GeolocationService - The request, timeout and JSON parsing run on the network I/O thread
 GeolocationService::GeolocationService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-    , m_timeoutTimer(new QTimer(this))
-    , m_currentReply(nullptr)
+    , m_pending(false)
 {
-    m_timeoutTimer->setSingleShot(true);
-    m_timeoutTimer->setInterval(Config::NETWORK_TIMEOUT_MS);
-    connect(m_timeoutTimer.get(), &QTimer::timeout, this, &GeolocationService::onNetworkTimeout);
+    NetworkService& network = NetworkService::instance();
+    connect(&network, &NetworkService::geolocationResolved, this, &GeolocationService::onGeolocationResolved);
+    connect(&network, &NetworkService::geolocationFailed, this, &GeolocationService::onGeolocationFailed);
 }
 
 void GeolocationService::detectUserLocation()
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply = nullptr;
-    }
-
-    QUrl url("https://ipapi.co/json/");
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader, "PandaBlur/1.0");
-    request.setRawHeader("Accept", "application/json");
+    // A lookup already in flight will answer this call as well
+    if (m_pending) return;
 
-    m_currentReply = m_networkManager->get(request);
-    m_timeoutTimer->start();
-
-    connect(m_currentReply, &QNetworkReply::finished, this, &GeolocationService::onLocationDataReceived);
+    m_pending = true;
+    NetworkService::instance().fetchGeolocation();
 }
 
-void GeolocationService::onNetworkTimeout()
+void GeolocationService::onGeolocationResolved(const QString &countryCode)
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply = nullptr;
-    }
+    if (!m_pending) return;
+    m_pending = false;
 
-    qDebug() << "Geolocation timeout, using default";
-    emit locationFailed();
+    QString languageCode = mapCountryToLanguage(countryCode);
+
+    qDebug() << "Detected location:" << countryCode << "->" << languageCode;
+    emit locationDetected(countryCode, languageCode);
 }
 
-void GeolocationService::onLocationDataReceived()
+void GeolocationService::onGeolocationFailed(const QString &error)
 {
-    m_timeoutTimer->stop();
-
-    if (!m_currentReply) return;
-
-    if (m_currentReply->error() == QNetworkReply::NoError) {
-        QByteArray data = m_currentReply->readAll();
-        QJsonDocument doc = QJsonDocument::fromJson(data);
-        QJsonObject obj = doc.object();
-
-        QString countryCode = obj["country_code"].toString().toLower();
-        QString languageCode = mapCountryToLanguage(countryCode);
+    if (!m_pending) return;
+    m_pending = false;
 
-        qDebug() << "Detected location:" << countryCode << "->" << languageCode;
-        emit locationDetected(countryCode, languageCode);
-    } else {
-        qDebug() << "Geolocation failed:" << m_currentReply->errorString();
-        emit locationFailed();
-    }
-
-    m_currentReply->deleteLater();
-    m_currentReply = nullptr;
+    qDebug() << "Geolocation failed, using default:" << error;
+    emit locationFailed();
 }
 
 QString GeolocationService::mapCountryToLanguage(const QString &countryCode)
@@ -663,30 +755,99 @@ QString GeolocationService::mapCountryToLanguage(const QString &countryCode)
     return countryToLanguage.value(countryCode, Config::DEFAULT_LANGUAGE);
 }
 
+// FrostedBackdrop - One grab and blur per popup opening
+FrostedBackdrop::FrostedBackdrop(int cornerRadius, QWidget *parent)
+    : QWidget(parent)
+    , m_cornerRadius(cornerRadius)
+    , m_fallbackColor(Qt::white)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setAttribute(Qt::WA_NoSystemBackground, true);
+}
+
+void FrostedBackdrop::capture(QWidget *source, const QRect &globalRect)
+{
+    m_backdrop = QPixmap();
+
+    // Below the full quality tier the popup gets a plain fill instead
+    if (!RenderQuality::instance().frostedBackdropEnabled()) {
+        update();
+        return;
+    }
+
+    // Grab a margin around the popup so its edges blur into real content
+    const int margin = 3 * Config::DROPDOWN_BACKDROP_BLUR;
+    const QRect area = source ? QRect(source->mapFromGlobal(globalRect.topLeft()), globalRect.size()) : QRect();
+    const QRect padded = area.adjusted(-margin, -margin, margin, margin);
+    const QRect visible = source ? padded.intersected(source->rect()) : QRect();
+
+    if (!visible.isEmpty()) {
+        const qreal dpr = source->devicePixelRatioF();
+        QImage image(FlagRasterCache::devicePixelSize(padded.size(), dpr), QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        image.setDevicePixelRatio(dpr);
+        {
+            QPainter painter(&image);
+            painter.drawPixmap(visible.topLeft() - padded.topLeft(), source->grab(visible));
+        }
+        BlurEngine::gaussianBlur(image, Config::DROPDOWN_BACKDROP_BLUR * dpr);
+
+        const QRect deviceArea(QPoint(qRound(margin * dpr), qRound(margin * dpr)),
+                               FlagRasterCache::devicePixelSize(area.size(), dpr));
+        m_backdrop = QPixmap::fromImage(image.copy(deviceArea));
+        m_backdrop.setDevicePixelRatio(dpr);
+    }
+    update();
+}
+
+void FrostedBackdrop::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    QPainterPath clip;
+    clip.addRoundedRect(rect(), m_cornerRadius, m_cornerRadius);
+    if (m_backdrop.isNull()) {
+        painter.fillPath(clip, m_fallbackColor);
+        return;
+    }
+    painter.setClipPath(clip);
+    painter.drawPixmap(0, 0, m_backdrop);
+}
+
 // ModernLanguageDropdown - Fully optimized with dynamic sizing and checkmarks
 ModernLanguageDropdown::ModernLanguageDropdown(QWidget *parent)
     : QPushButton(parent)
+    , m_languageFont("Segoe UI", 14, QFont::Medium)
+    , m_textColor(Theme::instance().color(Theme::Token::ControlText))
     , m_isHovered(false)
     , m_dropdownVisible(false)
+    , m_prewarmScheduled(false)
+    , m_dropdownPrewarmed(false)
+    , m_popupThemeDirty(true)
+    , m_firstOpenMs(-1)
     , m_currentLanguageCode("EN")
 {
     setFixedSize(Config::DROPDOWN_WIDTH, 45);
     setCursor(Qt::PointingHandCursor);
 
+    m_languageModel.reset(new LanguageListModel(this));
     setupLanguageOptions();
+    m_filterModel.reset(new LanguageFilterModel(m_languageModel.get(), this));
 
     m_currentLanguage = "English (UK)";
-    m_currentFlagUrl = "https://hatscripts.github.io/circle-flags/flags/gb.svg";
+    m_currentFlagUrl = FlagResolver::flagSource(Config::DEFAULT_COUNTRY);
+    m_languageModel->setSelectedRow(m_languageModel->rowForCountry(Config::DEFAULT_COUNTRY));
 
     m_currentFlag.reset(new CrispCircleFlagWidget(m_currentFlagUrl, this));
+    m_currentFlag->setFetchPriority(FlagLoader::Priority::Selected);
     // Better vertical centering for the flag in the button
     m_currentFlag->move(16, (height() - Config::FLAG_SIZE) / 2);
 
     m_animatedArrow.reset(new AnimatedArrowWidget(this));
     m_animatedArrow->move(width() - 32, (height() - 24) / 2);
 
-    setStyleSheet("background: transparent; border: none;");
-
     m_geolocationService.reset(new GeolocationService(this));
     connect(m_geolocationService.get(), &GeolocationService::locationDetected,
             this, &ModernLanguageDropdown::onLocationDetected);
@@ -712,25 +873,13 @@ ModernLanguageDropdown::~ModernLanguageDropdown()
 
 void ModernLanguageDropdown::setupLanguageOptions()
 {
-    m_languages = {
-        {"Nederlands", "NL", "nl"},
-        {"English (US)", "EN", "us"},
-        {"English (UK)", "EN", "gb"},
-        {"Deutsch", "DE", "de"},
-        {"Français", "FR", "fr"},
-        {"Español", "ES", "es"},
-        {"Italiano", "IT", "it"},
-        {"Português", "PT", "pt"},
-        {"Русский", "RU", "ru"},
-        {"中文", "CN", "cn"},
-        {"日本語", "JP", "jp"},
-        {"한국어", "KR", "kr"}
-    };
+    m_languageModel->setLanguages(Locales::all());
 }
 
 int ModernLanguageDropdown::calculateDropdownHeight() const
 {
-    int itemCount = m_languages.size();
+    // Height of the list; the search field sits above it
+    int itemCount = m_languageModel->rowCount();
     int totalHeight = itemCount * Config::DROPDOWN_ITEM_HEIGHT + 10;
     return std::min(totalHeight, Config::DROPDOWN_MAX_HEIGHT);
 }
@@ -738,138 +887,88 @@ int ModernLanguageDropdown::calculateDropdownHeight() const
 void ModernLanguageDropdown::createModernDropdown()
 {
     m_dropdownWidget.reset(new QWidget(nullptr));
+    m_dropdownWidget->setObjectName("languagePopup");
     m_dropdownWidget->setWindowFlags(Qt::Popup | Qt::FramelessWindowHint);
     m_dropdownWidget->setAttribute(Qt::WA_TranslucentBackground);
 
     int dropdownHeight = calculateDropdownHeight();
-    m_dropdownWidget->setFixedSize(Config::DROPDOWN_WIDTH, dropdownHeight);
+    const int listTop = Config::DROPDOWN_SEARCH_HEIGHT + Config::DROPDOWN_SEARCH_SPACING;
+    m_dropdownWidget->setFixedSize(Config::DROPDOWN_WIDTH, listTop + dropdownHeight);
     m_dropdownWidget->hide();
 
     auto* layout = new QVBoxLayout(m_dropdownWidget.get());
     layout->setContentsMargins(0, 0, 0, 0);
-
-    m_languageList.reset(new QListWidget(m_dropdownWidget.get()));
+    layout->setSpacing(Config::DROPDOWN_SEARCH_SPACING);
+
+    m_searchField.reset(new QLineEdit(m_dropdownWidget.get()));
+    m_searchField->setObjectName("languageSearch");
+    m_searchField->setPlaceholderText("Search languages");
+    m_searchField->setClearButtonEnabled(true);
+    m_searchField->setFixedSize(Config::DROPDOWN_WIDTH, Config::DROPDOWN_SEARCH_HEIGHT);
+    connect(m_searchField.get(), &QLineEdit::textChanged, this, &ModernLanguageDropdown::onSearchTextChanged);
+    connect(m_searchField.get(), &QLineEdit::returnPressed, this, &ModernLanguageDropdown::onSearchAccepted);
+    layout->addWidget(m_searchField.get());
+
+    // Rows are painted by the delegate; uniform sizes keep layout O(1) per scroll
+    m_languageList.reset(new QListView(m_dropdownWidget.get()));
     m_languageList->setFixedSize(Config::DROPDOWN_WIDTH, dropdownHeight);
-
-    // Load styles
-    QString dropdownStyle = ResourceManager::instance().getStyleSheet("dropdown");
-    if (!dropdownStyle.isEmpty()) {
-        m_languageList->setStyleSheet(dropdownStyle);
-    }
+    m_languageList->setModel(m_filterModel.get());
+    m_itemDelegate = new LanguageItemDelegate(m_languageModel.get(), m_languageList.get());
+    m_itemDelegate->setTextColor(Theme::instance().color(Theme::Token::ListText));
+    m_languageList->setItemDelegate(m_itemDelegate);
+    m_languageList->setUniformItemSizes(true);
+    m_languageList->setSelectionMode(QAbstractItemView::NoSelection);
+    m_languageList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_languageList->setMouseTracking(true);
+    m_languageList->viewport()->setAttribute(Qt::WA_Hover, true);
+    m_languageList->viewport()->setCursor(Qt::PointingHandCursor);
+
+    // Under the list; the list's translucent background lets the blurred window through
+    m_dropdownBackdrop.reset(new FrostedBackdrop(Config::DROPDOWN_RADIUS, m_dropdownWidget.get()));
+    m_dropdownBackdrop->setFallbackColor(Theme::instance().color(Theme::Token::PopupFallback));
+    m_dropdownBackdrop->setGeometry(0, listTop, Config::DROPDOWN_WIDTH, dropdownHeight);
+    m_dropdownBackdrop->lower();
 
     m_languageList->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     m_languageList->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
-    createDropdownItems();
+    connect(m_languageList.get(), &QListView::clicked, this, &ModernLanguageDropdown::onLanguageSelected);
+    // Scrolled-away rows give way to the ones that get painted next
+    connect(m_languageList->verticalScrollBar(), &QScrollBar::valueChanged,
+            m_languageModel.get(), &LanguageListModel::demoteFlagRequests);
     layout->addWidget(m_languageList.get());
+
+    // Paints of the list end the first-open measurement; hiding it demotes flag downloads
+    m_languageList->viewport()->installEventFilter(this);
 }
 
-void ModernLanguageDropdown::createDropdownItems()
-{
-    for (const auto &lang : m_languages) {
-        auto* item = new QListWidgetItem();
-
-        auto* itemWidget = new QWidget();
-        itemWidget->setFixedHeight(Config::DROPDOWN_ITEM_HEIGHT);
-        itemWidget->setContentsMargins(0, 0, 0, 0);
-
-        // ADD POINTER CURSOR TO THE ITEM WIDGET
-        itemWidget->setCursor(Qt::PointingHandCursor);
-
-        auto* itemLayout = new QHBoxLayout(itemWidget);
-        // Increased vertical margins for better flag centering
-        itemLayout->setContentsMargins(12, 15, 35, 15);
-        itemLayout->setSpacing(12);
-
-        // Flag widget - Better vertical alignment
-        auto* flagWidget = new CrispCircleFlagWidget("https://hatscripts.github.io/circle-flags/flags/" + lang.countryCode + ".svg", itemWidget);
-        flagWidget->setFixedSize(Config::FLAG_SIZE, Config::FLAG_SIZE);
-        flagWidget->setCursor(Qt::PointingHandCursor);  // ADD CURSOR TO FLAG
-        itemLayout->addWidget(flagWidget, 0, Qt::AlignVCenter);
-
-        // Language name label
-        auto* nameLabel = new QLabel(QString("%1 (%2)").arg(lang.name, lang.code), itemWidget);
-        nameLabel->setStyleSheet(
-            "QLabel {"
-            "    color: #1a1a1a;"
-            "    font-size: 15px;"
-            "    font-weight: 500;"
-            "    font-family: 'Segoe UI', Arial, sans-serif;"
-            "    margin: 0px; padding: 0px;"
-            "}"
-            );
-        nameLabel->setAlignment(Qt::AlignVCenter | Qt::AlignLeft);
-        nameLabel->setCursor(Qt::PointingHandCursor);  // ADD CURSOR TO LABEL
-        itemLayout->addWidget(nameLabel, 0, Qt::AlignVCenter);
-
-        // Reduced stretch to bring checkmark more to the left
-        itemLayout->addStretch(1);
-
-        // Checkmark widget - Better vertical alignment
-        auto* checkmarkWidget = new CrispSvgWidget(":/check.svg", itemWidget);
-        checkmarkWidget->setFixedSize(22, 22);
-        checkmarkWidget->setStyleSheet("background: transparent; margin-right: 10px;");
-        checkmarkWidget->setVisible(false); // Initially hidden
-        checkmarkWidget->setCursor(Qt::PointingHandCursor);  // ADD CURSOR TO CHECKMARK
-        itemLayout->addWidget(checkmarkWidget, 0, Qt::AlignVCenter);
-
-        // Store data
-        item->setData(Qt::UserRole, lang.code);
-        item->setData(Qt::UserRole + 1, lang.name);
-        item->setData(Qt::UserRole + 2, lang.countryCode);
-        item->setData(Qt::UserRole + 3, QVariant::fromValue(checkmarkWidget));
-        item->setSizeHint(QSize(Config::DROPDOWN_WIDTH, Config::DROPDOWN_ITEM_HEIGHT));
-
-        m_languageList->addItem(item);
-        m_languageList->setItemWidget(item, itemWidget);
-    }
+void ModernLanguageDropdown::prewarmDropdown()
+{
+    if (m_dropdownPrewarmed || !m_dropdownWidget) return;
+    m_dropdownPrewarmed = true;
 
-    connect(m_languageList.get(), &QListWidget::itemClicked, [this](QListWidgetItem *item) {
-        QString code = item->data(Qt::UserRole).toString();
-        QString name = item->data(Qt::UserRole + 1).toString();
-        onLanguageSelected(name, code);
-    });
-}
-
-void ModernLanguageDropdown::updateCheckmarks()
-{
-    // Hide all checkmarks first
-    for (int i = 0; i < m_languageList->count(); ++i) {
-        QListWidgetItem* item = m_languageList->item(i);
-        if (item) {
-            QVariant checkmarkData = item->data(Qt::UserRole + 3);
-            if (checkmarkData.isValid()) {
-                auto* checkmarkWidget = checkmarkData.value<CrispSvgWidget*>();
-                if (checkmarkWidget) {
-                    checkmarkWidget->setVisible(false);
-                }
-            }
-        }
-    }
+    QElapsedTimer timer;
+    timer.start();
 
-    // Show checkmark for selected language
-    for (int i = 0; i < m_languageList->count(); ++i) {
-        QListWidgetItem* item = m_languageList->item(i);
-        if (item) {
-            QString itemCode = item->data(Qt::UserRole).toString();
-            if (itemCode == m_currentLanguageCode) {
-                QVariant checkmarkData = item->data(Qt::UserRole + 3);
-                if (checkmarkData.isValid()) {
-                    auto* checkmarkWidget = checkmarkData.value<CrispSvgWidget*>();
-                    if (checkmarkWidget) {
-                        checkmarkWidget->setVisible(true);
-                    }
-                }
-                break;
-            }
-        }
-    }
+    // Native window, style sheet polish and layout, all while hidden
+    applyPopupTheme();
+    m_dropdownWidget->winId();
+    m_dropdownWidget->ensurePolished();
+    m_languageList->ensurePolished();
+    m_dropdownWidget->layout()->activate();
+    m_languageList->doItemsLayout();
+
+    // One offscreen render runs the delegate for the visible rows: flag
+    // rasters, laid-out text and the checkmark state are cached afterwards
+    m_dropdownWidget->grab();
+
+    qDebug() << "Language popup prewarmed in" << timer.elapsed() << "ms";
 }
 
 void ModernLanguageDropdown::onLocationDetected(const QString &countryCode, const QString &languageCode)
 {
     qDebug() << "Setting language based on location:" << countryCode << "->" << languageCode;
-    setLanguageByCode(languageCode);
+    setLanguageByCode(languageCode, countryCode.toLower());
 }
 
 void ModernLanguageDropdown::onLocationFailed()
@@ -878,21 +977,61 @@ void ModernLanguageDropdown::onLocationFailed()
     setLanguageByCode(Config::DEFAULT_LANGUAGE);
 }
 
-void ModernLanguageDropdown::setLanguageByCode(const QString &languageCode)
+void ModernLanguageDropdown::setLanguageByCode(const QString &languageCode, const QString &countryCode)
 {
-    for (const auto &lang : m_languages) {
-        if (lang.code == languageCode) {
-            m_currentLanguage = lang.name;
-            m_currentLanguageCode = languageCode;
-            m_currentFlagUrl = "https://hatscripts.github.io/circle-flags/flags/" + lang.countryCode + ".svg";
-            m_currentFlag->setFlag(m_currentFlagUrl);
-            update();
-            updateCheckmarks();
+    const int row = m_languageModel->rowForCode(languageCode, countryCode);
+    if (row < 0) return;
 
-            emit languageChanged(languageCode);
-            return;
-        }
+    selectRow(row);
+    emit languageChanged(languageCode);
+}
+
+void ModernLanguageDropdown::applyTheme()
+{
+    const Theme &theme = Theme::instance();
+    m_textColor = theme.color(Theme::Token::ControlText);
+    m_itemDelegate->setTextColor(theme.color(Theme::Token::ListText));
+    m_dropdownBackdrop->setFallbackColor(theme.color(Theme::Token::PopupFallback));
+    update();
+
+    // Re-polishing the popup is the expensive part; a closed popup waits for its next opening
+    m_popupThemeDirty = true;
+    if (m_dropdownVisible) {
+        applyPopupTheme();
+    }
+}
+
+void ModernLanguageDropdown::applyPopupTheme()
+{
+    if (!m_popupThemeDirty) return;
+    m_popupThemeDirty = false;
+
+    const bool darkMode = Theme::instance().isDark();
+    if (m_dropdownWidget->property("darkMode").toBool() == darkMode) {
+        m_languageList->viewport()->update();
+        return;
     }
+
+    // [darkMode="true"] rules only apply once the popup and its children are polished again
+    m_dropdownWidget->setProperty("darkMode", darkMode);
+    QList<QWidget *> widgets = m_dropdownWidget->findChildren<QWidget *>();
+    widgets.prepend(m_dropdownWidget.get());
+    for (QWidget *widget : std::as_const(widgets)) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+    }
+    m_dropdownWidget->update();
+}
+
+void ModernLanguageDropdown::selectRow(int row)
+{
+    const Locale &language = m_languageModel->language(row);
+    m_currentLanguage = language.nativeName;
+    m_currentLanguageCode = language.code;
+    m_currentFlagUrl = FlagResolver::flagSource(language.countryCode);
+    m_currentFlag->setFlag(m_currentFlagUrl);
+    m_languageModel->setSelectedRow(row);
+    update();
 }
 
 void ModernLanguageDropdown::positionDropdownBelowButton()
@@ -925,36 +1064,41 @@ void ModernLanguageDropdown::positionDropdownBelowButton()
 
 void ModernLanguageDropdown::paintEvent(QPaintEvent *event)
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    // REMOVED HOVER EFFECT - Always use the same colors
-    QColor backgroundColor = QColor(255, 255, 255, 255);  // Always white
-    QColor borderColor = QColor(230, 230, 230, 180);     // Always light gray
-
-    // Draw background
-    QPainterPath backgroundPath;
-    backgroundPath.addRoundedRect(rect(), 12, 12);
-    painter.setBrush(backgroundColor);
-    painter.setPen(Qt::NoPen);
-    painter.drawPath(backgroundPath);
+    Q_UNUSED(event);
+
+    // REMOVED HOVER EFFECT - one cached image per scheme covers background and border
+    const Theme &theme = Theme::instance();
+    const QColor backgroundColor = theme.color(Theme::Token::ControlBackground);
+    const QColor borderColor = theme.color(Theme::Token::ControlBorder);
+    const QPixmap background = PaintCache::instance().state(theme.stateKey("language-dropdown/button"), size(),
+                                                            devicePixelRatioF(),
+        [backgroundColor, borderColor](QPainter *painter, const QSize &size) {
+            const QRectF bounds(QPointF(0, 0), size);
+
+            QPainterPath backgroundPath;
+            backgroundPath.addRoundedRect(bounds, 12, 12);
+            painter->setBrush(backgroundColor);
+            painter->setPen(Qt::NoPen);
+            painter->drawPath(backgroundPath);
+
+            QPainterPath borderPath;
+            borderPath.addRoundedRect(bounds.adjusted(0.75, 0.75, -0.75, -0.75), 11.25, 11.25);
+            painter->setBrush(Qt::NoBrush);
+            painter->setPen(QPen(borderColor, 1.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            painter->drawPath(borderPath);
+        });
 
-    // Draw border
-    QPainterPath borderPath;
-    QRectF borderRect = rect().adjusted(0.75, 0.75, -0.75, -0.75);
-    borderPath.addRoundedRect(borderRect, 11.25, 11.25);
-
-    painter.setBrush(Qt::NoBrush);
-    painter.setPen(QPen(borderColor, 1.5, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-    painter.drawPath(borderPath);
-
-    // Draw language name
-    painter.setPen(QPen(QColor(26, 26, 26), 1));
-    QFont textFont("Segoe UI", 14, QFont::Medium);
-    painter.setFont(textFont);
-    painter.drawText(QRect(55, 0, width() - 85, height()), Qt::AlignVCenter, m_currentLanguage);
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
 
-    QPushButton::paintEvent(event);
+    // Language name, laid out once per language and font
+    const QRect textRect(55, 0, width() - 85, height());
+    const QStaticText text = PaintCache::instance().staticText(m_currentLanguage, m_languageFont);
+    painter.setClipRect(textRect);
+    painter.setFont(m_languageFont);
+    painter.setPen(QPen(m_textColor, 1));
+    painter.drawStaticText(QPointF(textRect.left(), textRect.top() + (textRect.height() - text.size().height()) / 2),
+                           text);
 }
 
 void ModernLanguageDropdown::showDropdown()
@@ -964,34 +1108,50 @@ void ModernLanguageDropdown::showDropdown()
         m_dropdownVisible = false;
         m_animatedArrow->animateToDown();
     } else {
+        if (m_firstOpenMs < 0 && !m_openTimer.isValid()) {
+            m_openTimer.start();
+        }
+        // A click before the idle prewarm ran does the same work up front
+        prewarmDropdown();
+        applyPopupTheme();
         positionDropdownBelowButton();
-        updateCheckmarks(); // Update checkmarks when showing dropdown
+        m_dropdownBackdrop->capture(window(), m_dropdownWidget->geometry().adjusted(0, m_languageList->y(), 0, 0));
+        // Every opening starts from the full list with the caret in the search field
+        m_searchField->clear();
+        m_languageList->scrollToTop();
         m_dropdownWidget->show();
         m_dropdownWidget->raise();
+        m_searchField->setFocus(Qt::PopupFocusReason);
         m_dropdownVisible = true;
         m_animatedArrow->animateToUp();
     }
 }
 
-void ModernLanguageDropdown::onLanguageSelected(const QString &language, const QString &code)
+void ModernLanguageDropdown::onLanguageSelected(const QModelIndex &index)
 {
-    for (const auto &lang : m_languages) {
-        if (lang.code == code && lang.name == language) {
-            m_currentLanguage = lang.name;
-            m_currentLanguageCode = code;
-            m_currentFlagUrl = "https://hatscripts.github.io/circle-flags/flags/" + lang.countryCode + ".svg";
-            m_currentFlag->setFlag(m_currentFlagUrl);
-            break;
-        }
-    }
+    if (!index.isValid()) return;
 
-    updateCheckmarks();
+    selectRow(m_filterModel->mapToSource(index).row());
 
     m_dropdownWidget->hide();
     m_dropdownVisible = false;
     m_animatedArrow->animateToDown();
 
-    emit languageChanged(code);
+    emit languageChanged(m_currentLanguageCode);
+}
+
+void ModernLanguageDropdown::onSearchTextChanged(const QString &text)
+{
+    m_filterModel->setQuery(text);
+    m_languageList->scrollToTop();
+    m_languageModel->demoteFlagRequests();
+}
+
+void ModernLanguageDropdown::onSearchAccepted()
+{
+    // Enter picks the first match; with nothing typed there is nothing to pick
+    if (m_searchField->text().trimmed().isEmpty()) return;
+    onLanguageSelected(m_filterModel->index(0, 0));
 }
 
 void ModernLanguageDropdown::resizeEvent(QResizeEvent *event)
@@ -1008,6 +1168,39 @@ void ModernLanguageDropdown::resizeEvent(QResizeEvent *event)
     QPushButton::resizeEvent(event);
 }
 
+void ModernLanguageDropdown::showEvent(QShowEvent *event)
+{
+    QPushButton::showEvent(event);
+
+    // Prepare the popup once the first frame is on screen and the event loop is idle
+    if (!m_prewarmScheduled) {
+        m_prewarmScheduled = true;
+        QTimer::singleShot(Config::DROPDOWN_PREWARM_DELAY_MS, this, &ModernLanguageDropdown::prewarmDropdown);
+    }
+}
+
+bool ModernLanguageDropdown::eventFilter(QObject *watched, QEvent *event)
+{
+    // A closed popup shows no rows at all
+    if (event->type() == QEvent::Hide && m_languageList && watched == m_languageList->viewport()) {
+        m_languageModel->demoteFlagRequests();
+    }
+
+    // The prewarm grab() paints the viewport offscreen while the popup is
+    // still hidden; only a paint of the mapped popup ends the measurement
+    if (event->type() == QEvent::Paint && m_openTimer.isValid() && m_languageList
+        && watched == m_languageList->viewport() && m_dropdownWidget->isVisible()) {
+        // Stamped after this paint has been flushed, not when it starts
+        QTimer::singleShot(0, this, [this]() {
+            if (!m_openTimer.isValid()) return;
+            m_firstOpenMs = m_openTimer.elapsed();
+            m_openTimer.invalidate();
+            qDebug() << "Language popup first open:" << m_firstOpenMs << "ms";
+        });
+    }
+    return QPushButton::eventFilter(watched, event);
+}
+
 void ModernLanguageDropdown::mousePressEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
@@ -1033,16 +1226,22 @@ void ModernLanguageDropdown::leaveEvent(QEvent *event)
 // WelcomeCard - Optimized with properly sized panda
 WelcomeCard::WelcomeCard(QWidget *parent)
     : QFrame(parent)
-    , m_darkMode(false)
+    , m_renderingStaticLayer(false)
 {
     setFixedSize(Config::CARD_WIDTH, Config::CARD_HEIGHT);
     setFrameStyle(QFrame::NoFrame);
 
     setupUI();
+    applyTheme();
+
+    // The panda is baked into the layer, so a reloaded asset has to rebuild it
+    connect(&SvgAssetRegistry::instance(), &SvgAssetRegistry::assetChanged,
+            this, &WelcomeCard::invalidateStaticLayer);
 }
 
 void WelcomeCard::setupUI()
 {
+    m_staticWidgets.clear();
     setupWindowControls();
 
     auto* mainLayout = new QHBoxLayout(this);
@@ -1052,17 +1251,16 @@ void WelcomeCard::setupUI()
     // Left side - illustration with PROPERLY SIZED PANDA
     m_illustrationContainer.reset(new QWidget(this));
     m_illustrationContainer->setFixedSize(400, 500); // Increased size for better fit
-    m_illustrationContainer->setStyleSheet("background: transparent; border: none;");
+    m_illustrationContainer->setObjectName("illustrationContainer");
 
     // Create a proper container for the panda SVG
     auto* pandaContainer = new QWidget(m_illustrationContainer.get());
     pandaContainer->setFixedSize(380, 480); // Slightly smaller than container
     pandaContainer->move(10, 10); // Center in container
-    pandaContainer->setStyleSheet("background: transparent; border: none;");
+    pandaContainer->setObjectName("pandaContainer");
 
     // Use your actual panda.svg file with proper aspect ratio
     m_pandaSvg.reset(new CrispSvgWidget("panda.svg", pandaContainer));
-    m_pandaSvg->setStyleSheet("background: transparent; border: none;");
 
     // Set a reasonable size that maintains aspect ratio
     m_pandaSvg->setFixedSize(380, 480);
@@ -1077,31 +1275,14 @@ void WelcomeCard::setupUI()
 
     // Title
     m_titleLabel.reset(new QLabel("Welcome to\nPandaBlur", this));
-    m_titleLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #000000;"
-        "    font-size: 42px;"
-        "    font-weight: 900;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "    line-height: 1.1;"
-        "}"
-        );
+    m_titleLabel->setObjectName("titleLabel");
     m_titleLabel->setAlignment(Qt::AlignLeft);
     m_titleLabel->setWordWrap(true);
     m_titleLabel->setFixedWidth(400);
 
     // Subtitle
     m_subtitleLabel.reset(new QLabel("PandaBlur is a Security Software\nto protect your devices!", this));
-    m_subtitleLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #5a6c7d;"
-        "    font-size: 22px;"
-        "    font-weight: normal;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "    line-height: 1.4;"
-        "    margin-top: 5px;"
-        "}"
-        );
+    m_subtitleLabel->setObjectName("subtitleLabel");
     m_subtitleLabel->setAlignment(Qt::AlignLeft);
     m_subtitleLabel->setWordWrap(true);
     m_subtitleLabel->setFixedWidth(400);
@@ -1114,15 +1295,7 @@ void WelcomeCard::setupUI()
 
     // Auto-translate label
     m_autoTranslateLabel.reset(new QLabel("Detects and translates language automatically", this));
-    m_autoTranslateLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #888888;"
-        "    font-size: 13px;"
-        "    font-weight: normal;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "    margin-top: 3px;"
-        "}"
-        );
+    m_autoTranslateLabel->setObjectName("autoTranslateLabel");
     m_autoTranslateLabel->setAlignment(Qt::AlignLeft);
     m_autoTranslateLabel->setFixedWidth(400);
 
@@ -1160,6 +1333,12 @@ void WelcomeCard::setupUI()
     mainLayout->addWidget(m_illustrationContainer.get(), 0, Qt::AlignCenter);
     mainLayout->addWidget(contentWidget, 1);
 
+    addToStaticLayer(m_pandaSvg.get());
+    addToStaticLayer(m_titleLabel.get());
+    addToStaticLayer(m_subtitleLabel.get());
+    addToStaticLayer(m_autoTranslateLabel.get());
+    updateAccessibleText();
+
     // Connect to main window
     auto* mainWindow = qobject_cast<MainWindow*>(parent());
     if (mainWindow) {
@@ -1204,31 +1383,31 @@ void WelcomeCard::updateLanguage(const QString &languageCode)
     m_subtitleLabel->setText(subtitle);
     m_continueButton->updateText(continueText);
     m_autoTranslateLabel->setText(autoTranslate);
+    updateAccessibleText();
+
+    // Hidden labels do not repaint themselves
+    invalidateStaticLayer();
 }
 
-void WelcomeCard::setDarkMode(bool enabled)
-{
-    m_darkMode = enabled;
-    setProperty("darkMode", enabled);
-
-    if (enabled) {
-        setStyleSheet("QFrame { background-color: #2b2b2b; }");
-        m_titleLabel->setStyleSheet(
-            "QLabel { color: #ffffff; font-size: 42px; font-weight: 900; "
-            "font-family: 'Segoe UI', Arial, sans-serif; line-height: 1.1; }"
-            );
-        m_subtitleLabel->setStyleSheet(
-            "QLabel { color: #cccccc; font-size: 22px; font-weight: normal; "
-            "font-family: 'Segoe UI', Arial, sans-serif; line-height: 1.4; margin-top: 5px; }"
-            );
-        m_autoTranslateLabel->setStyleSheet(
-            "QLabel { color: #999999; font-size: 13px; font-weight: normal; "
-            "font-family: 'Segoe UI', Arial, sans-serif; margin-top: 3px; }"
-            );
-    } else {
-        setStyleSheet("");
-        setupUI();
+void WelcomeCard::applyTheme()
+{
+    // Label colours are palette entries, not style sheet rules: no re-polish
+    const Theme &theme = Theme::instance();
+    const std::pair<QLabel *, Theme::Token> labels[] = {
+        {m_titleLabel.get(), Theme::Token::TitleText},
+        {m_subtitleLabel.get(), Theme::Token::SubtitleText},
+        {m_autoTranslateLabel.get(), Theme::Token::CaptionText},
+    };
+    for (const auto &[label, token] : labels) {
+        QPalette palette = label->palette();
+        palette.setColor(QPalette::WindowText, theme.color(token));
+        label->setPalette(palette);
     }
+
+    m_languageDropdown->applyTheme();
+
+    // The layer repaints the card background from the new tokens
+    invalidateStaticLayer();
 }
 
 void WelcomeCard::onLanguageChanged(const QString &languageCode)
@@ -1239,6 +1418,7 @@ void WelcomeCard::onLanguageChanged(const QString &languageCode)
 void WelcomeCard::resizeEvent(QResizeEvent *event)
 {
     adjustLayout();
+    invalidateStaticLayer();
     QFrame::resizeEvent(event);
 }
 
@@ -1247,22 +1427,93 @@ void WelcomeCard::adjustLayout()
     // Responsive layout adjustments
 }
 
-void WelcomeCard::paintEvent(QPaintEvent *event)
+void WelcomeCard::updateAccessibleText()
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    // Hidden labels are not in the accessibility tree; the card speaks for them
+    setAccessibleName(m_titleLabel->text().simplified());
+    setAccessibleDescription(m_subtitleLabel->text().simplified() + '\n' + m_autoTranslateLabel->text());
+}
 
-    QPainterPath path;
-    path.addRoundedRect(rect(), Config::CARD_RADIUS, Config::CARD_RADIUS);
+void WelcomeCard::addToStaticLayer(QWidget *widget)
+{
+    // Keeps its slot in the layout but is only ever painted into the layer
+    QSizePolicy policy = widget->sizePolicy();
+    policy.setRetainSizeWhenHidden(true);
+    widget->setSizePolicy(policy);
+    widget->hide();
+    widget->installEventFilter(this);
+    m_staticWidgets.append(widget);
+}
+
+void WelcomeCard::invalidateStaticLayer()
+{
+    m_staticLayer = QPixmap();
+    update();
+}
 
-    QColor backgroundColor = m_darkMode ? QColor(43, 43, 43, 255) : QColor(255, 255, 255, 255);
-    QColor borderColor = m_darkMode ? QColor(85, 85, 85, 255) : QColor(224, 224, 224, 255);
+bool WelcomeCard::eventFilter(QObject *watched, QEvent *event)
+{
+    // Only the static widgets are filtered. render() flushes their deferred
+    // move/resize events, which describe the geometry being drawn anyway.
+    if (m_renderingStaticLayer) {
+        return QFrame::eventFilter(watched, event);
+    }
 
-    painter.setBrush(QBrush(backgroundColor));
-    painter.setPen(QPen(borderColor, 1));
+    switch (event->type()) {
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::StyleChange:
+    case QEvent::FontChange:
+    case QEvent::PaletteChange:
+        invalidateStaticLayer();
+        break;
+    default:
+        break;
+    }
+    return QFrame::eventFilter(watched, event);
+}
+
+void WelcomeCard::rebuildStaticLayer(qreal devicePixelRatio)
+{
+    m_staticLayer = QPixmap(FlagRasterCache::devicePixelSize(size(), devicePixelRatio));
+    m_staticLayer.setDevicePixelRatio(devicePixelRatio);
+    m_staticLayer.fill(Qt::transparent);
+
+    // Painted straight into the layer: at card size a PaintCache state would
+    // evict the small control states, or not fit the budget at all on HiDPI
+    const Theme &theme = Theme::instance();
+    QPainter painter(&m_staticLayer);
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    QPainterPath path;
+    path.addRoundedRect(QRectF(QPointF(0, 0), size()), Config::CARD_RADIUS, Config::CARD_RADIUS);
+    painter.setBrush(QBrush(theme.color(Theme::Token::CardBackground)));
+    painter.setPen(QPen(theme.color(Theme::Token::CardBorder), 1));
     painter.drawPath(path);
+    painter.restore();
+
+    m_renderingStaticLayer = true;
+    for (const QPointer<QWidget> &widget : std::as_const(m_staticWidgets)) {
+        if (widget) {
+            widget->render(&painter, widget->mapTo(this, QPoint(0, 0)), QRegion(), QWidget::DrawChildren);
+        }
+    }
+    m_renderingStaticLayer = false;
+}
+
+void WelcomeCard::paintEvent(QPaintEvent *event)
+{
+    const qreal dpr = devicePixelRatioF();
+    if (m_staticLayer.isNull() || m_staticLayer.devicePixelRatio() != dpr) {
+        rebuildStaticLayer(dpr);
+    }
 
-    QFrame::paintEvent(event);
+    // Copies just the invalidated rects; dynamic children composite over them
+    QPainter painter(this);
+    for (const QRect &rect : event->region()) {
+        painter.drawPixmap(QRectF(rect), m_staticLayer,
+                           QRectF(QPointF(rect.topLeft()) * dpr, QSizeF(rect.size()) * dpr));
+    }
 }
 
 // MainWindow - Optimized with better window management
@@ -1272,6 +1523,16 @@ MainWindow::MainWindow(QWidget *parent)
 {
     setupUI();
     centerWindow();
+
+    connect(&Theme::instance(), &Theme::schemeChanged, this, &MainWindow::applyTheme);
+}
+
+void MainWindow::applyTheme()
+{
+    // Every widget invalidates itself; the window repaints once when updates come back on
+    setUpdatesEnabled(false);
+    m_welcomeCard->applyTheme();
+    setUpdatesEnabled(true);
 }
 
 void MainWindow::setupUI()
@@ -1282,21 +1543,18 @@ void MainWindow::setupUI()
 
     auto* centralWidget = new QWidget(this);
     setCentralWidget(centralWidget);
-    centralWidget->setStyleSheet("background: transparent;");
+    centralWidget->setObjectName("centralWidget");
 
     auto* mainLayout = new QVBoxLayout(centralWidget);
     mainLayout->setContentsMargins(50, 60, 50, 60);
     mainLayout->setAlignment(Qt::AlignCenter);
 
     m_welcomeCard.reset(new WelcomeCard(this));
-
-    auto* cardShadow = new QGraphicsDropShadowEffect();
-    cardShadow->setBlurRadius(50);
-    cardShadow->setColor(QColor(0, 0, 0, 60));
-    cardShadow->setOffset(0, 20);
-    m_welcomeCard->setGraphicsEffect(cardShadow);
-
     mainLayout->addWidget(m_welcomeCard.get(), 0, Qt::AlignCenter);
+
+    // Blurred once into a nine-patch; updates inside the card no longer re-run a blur
+    DropShadowWidget::attach(m_welcomeCard.get(),
+                             ShadowSpec{Config::CARD_RADIUS, 50, QColor(0, 0, 0, 60), QPoint(0, 20)});
 }
 
 void MainWindow::centerWindow()
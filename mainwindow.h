@@ -8,27 +8,28 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
+#include <QLineEdit>
 #include <QPropertyAnimation>
-#include <QGraphicsDropShadowEffect>
 #include <QSvgRenderer>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
 #include <QTimer>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QHash>
 #include <QPixmap>
+#include <QPointer>
+#include <QFont>
+#include <QElapsedTimer>
 #include <memory>
 #include "config.h"
+#include "flagrastercache.h"
+#include "flagloader.h"
+#include "languagelist.h"
 
 QT_BEGIN_NAMESPACE
 class QSvgRenderer;
 class QPropertyAnimation;
-class QNetworkAccessManager;
-class QNetworkReply;
 class QTimer;
+class QWindow;
+class QPainter;
 QT_END_NAMESPACE
 
 // Forward declarations
@@ -37,12 +38,20 @@ class SimpleButton;
 class WindowControlButton;
 class AnimatedArrowWidget;
 class CrispCircleFlagWidget;
+class FrostedBackdrop;
 class ModernLanguageDropdown;
 class GeolocationService;
 class ResourceManager;
 class WelcomeCard;
 
 // CrispSvgWidget - High-quality SVG rendering widget
+//
+// The aspect-fitted document is rasterized once at the widget's exact
+// device pixel size and kept; it is only redrawn when the widget is
+// resized, moves to a screen with a different DPR, or the renderer loads
+// a new document. A steady-state paint is a single 1:1 blit. Rasters come
+// from SvgAssetRegistry, so widgets showing the same asset at the same size
+// share one pixmap, and compiled-in icons never go through QtSvg.
 class CrispSvgWidget : public QWidget
 {
     Q_OBJECT
@@ -50,13 +59,17 @@ class CrispSvgWidget : public QWidget
 public:
     explicit CrispSvgWidget(const QString &file = QString(), QWidget *parent = nullptr);
 
-    QSvgRenderer* renderer() const { return m_svgRenderer.get(); }
-
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void onAssetChanged(const QString &name);
 
 private:
-    std::unique_ptr<QSvgRenderer> m_svgRenderer;
+    QString m_assetName;
+    bool m_hasAsset;
+    QPixmap m_cachedPixmap;
 };
 
 // SimpleButton - Styled button with hover effects
@@ -73,6 +86,9 @@ private:
 };
 
 // WindowControlButton - Custom minimize/close buttons
+//
+// Normal and hover looks are pre-rendered through PaintCache, so a hover
+// change repaints by blitting the other state.
 class WindowControlButton : public QPushButton
 {
     Q_OBJECT
@@ -86,12 +102,20 @@ protected:
     void leaveEvent(QEvent *event) override;
 
 private:
+    void paintState(QPainter *painter, const QRect &bounds, bool hovered) const;
+
     QString m_filePath;
-    std::unique_ptr<QSvgRenderer> m_svgRenderer;
+    bool m_hasIcon;
     bool m_isHovered;
 };
 
 // AnimatedArrowWidget - Rotating arrow for dropdown
+//
+// Every rotation step is pre-rendered once into a strip of
+// Config::ARROW_ROTATION_FRAMES frames (via PaintCache). An animation tick
+// only picks a frame and, if it changed, invalidates the arrow's own rect;
+// painting is a 1:1 blit of that frame. The animation length follows
+// RenderQuality; the minimal tier does not animate.
 class AnimatedArrowWidget : public QWidget
 {
     Q_OBJECT
@@ -110,8 +134,11 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
+    void animateTo(qreal rotation);
+    static int frameFor(qreal rotation);
+
     qreal m_rotation;
-    std::unique_ptr<QSvgRenderer> m_arrowRenderer;
+    int m_frame;
     std::unique_ptr<QPropertyAnimation> m_rotationAnimation;
 };
 
@@ -122,34 +149,47 @@ class CrispCircleFlagWidget : public QWidget
 
 public:
     explicit CrispCircleFlagWidget(const QString &flagUrl, QWidget *parent = nullptr);
+    ~CrispCircleFlagWidget();
 
     void setFlag(const QString &flagUrl);
+    void setFetchPriority(FlagLoader::Priority priority);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
 
 private slots:
-    void onFlagDownloaded();
-    void onNetworkTimeout();
+    void onFlagLoaded(const QString &flagUrl, const QByteArray &svgData);
+    void onFlagFailed(const QString &flagUrl);
+    void onFlagInvalidated(const QString &flagUrl);
+    void onRasterReady(const FlagRasterKey &key, const QPixmap &pixmap);
+    void onScreenChanged();
 
 private:
     void renderFlag();
+    void cancelPendingRaster();
+    bool isAtlasFlag() const;
+    bool useAtlas();
+    bool useCachedRaster();
+    bool loadFromDiskCache(const QString &flagUrl);
+    QByteArray loadSvgData() const;
+    FlagRasterKey rasterKey() const;
     int calculateOptimalScale() const;
 
     QString m_currentFlagUrl;
-    std::unique_ptr<QSvgRenderer> m_svgRenderer;
-    std::unique_ptr<QNetworkAccessManager> m_networkManager;
-    std::unique_ptr<QTimer> m_timeoutTimer;
-    QNetworkReply *m_currentReply;
+    QString m_contentHash;
+    QByteArray m_svgData;
+    QPointer<QWindow> m_trackedWindow;
+    FlagRasterKey m_pendingKey;
+    QRect m_atlasRect;
+    FlagLoader::Priority m_fetchPriority;
 
     QPixmap m_cachedPixmap;
     bool m_isLoading;
     bool m_pixmapCached;
-
-    static QHash<QString, QPixmap> s_flagCache;
 };
 
-// GeolocationService - IP-based location detection
+// GeolocationService - IP-based location detection on the network I/O thread
 class GeolocationService : public QObject
 {
     Q_OBJECT
@@ -164,15 +204,13 @@ signals:
     void locationFailed();
 
 private slots:
-    void onLocationDataReceived();
-    void onNetworkTimeout();
+    void onGeolocationResolved(const QString &countryCode);
+    void onGeolocationFailed(const QString &error);
 
 private:
     QString mapCountryToLanguage(const QString &countryCode);
 
-    std::unique_ptr<QNetworkAccessManager> m_networkManager;
-    std::unique_ptr<QTimer> m_timeoutTimer;
-    QNetworkReply *m_currentReply;
+    bool m_pending;
 };
 
 // ResourceManager - Singleton for managing resources and translations
@@ -193,7 +231,42 @@ private:
     ResourceManager& operator=(const ResourceManager&) = delete;
 };
 
+// FrostedBackdrop - Blurred snapshot of the window behind a translucent popup
+//
+// capture() grabs the part of the source window under the popup once per
+// opening and blurs it with BlurEngine; painting is a clipped blit. Parts of
+// the popup outside the source window stay clear. Below the full
+// RenderQuality tier nothing is grabbed and the fallback colour is filled.
+class FrostedBackdrop : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FrostedBackdrop(int cornerRadius, QWidget *parent = nullptr);
+
+    void capture(QWidget *source, const QRect &globalRect);
+    // Theme::Token::PopupFallback, applied by ModernLanguageDropdown::applyTheme()
+    void setFallbackColor(const QColor &color) { m_fallbackColor = color; update(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    int m_cornerRadius;
+    QColor m_fallbackColor;
+    QPixmap m_backdrop;
+};
+
 // ModernLanguageDropdown - Advanced language selector with flags and animations
+//
+// The popup is a search field over a QListView showing every locale in
+// Locales::all() through LanguageFilterModel, painted by
+// LanguageItemDelegate: rows are not widgets, and only rows scrolled into
+// view fetch and rasterize their flags. Typing filters the same rows
+// through the model's LocaleIndex. Shortly after the button is first
+// shown the hidden popup gets its native window, polish, layout and one
+// offscreen render, so the first click only maps it. The latency from
+// that click to the popup's first paint is measured and logged.
 class ModernLanguageDropdown : public QPushButton
 {
     Q_OBJECT
@@ -202,53 +275,76 @@ public:
     explicit ModernLanguageDropdown(QWidget *parent = nullptr);
     ~ModernLanguageDropdown();
 
-    void setLanguageByCode(const QString &languageCode);
+    // Prefers the locale of countryCode when several share the language code
+    void setLanguageByCode(const QString &languageCode, const QString &countryCode = QString());
+    // Milliseconds from the first click to the popup's first paint, -1 before that
+    qint64 firstOpenLatencyMs() const { return m_firstOpenMs; }
+    // Button and list colours now; the popup's style rules when it next opens
+    void applyTheme();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void enterEvent(QEnterEvent *event) override;
     void leaveEvent(QEvent *event) override;
 
 private slots:
     void showDropdown();
+    void prewarmDropdown();
+    void onSearchTextChanged(const QString &text);
+    void onSearchAccepted();
     void onLocationDetected(const QString &countryCode, const QString &languageCode);
     void onLocationFailed();
-    void onLanguageSelected(const QString &language, const QString &code);
+    void onLanguageSelected(const QModelIndex &index);
 
 signals:
     void languageChanged(const QString &languageCode);
 
 private:
-    struct LanguageOption {
-        QString name;
-        QString code;
-        QString countryCode;
-    };
-
     void setupLanguageOptions();
     void createModernDropdown();
-    void createDropdownItems();
     void positionDropdownBelowButton();
     int calculateDropdownHeight() const;
-    void updateCheckmarks();
+    void selectRow(int row);
+    void applyPopupTheme();
 
-    QList<LanguageOption> m_languages;
+    std::unique_ptr<LanguageListModel> m_languageModel;
+    std::unique_ptr<LanguageFilterModel> m_filterModel;
     QString m_currentLanguage;
+    QFont m_languageFont;
+    QColor m_textColor;
     QString m_currentFlagUrl;
     bool m_isHovered;
     bool m_dropdownVisible;
+    bool m_prewarmScheduled;
+    bool m_dropdownPrewarmed;
+    bool m_popupThemeDirty;         // popup not re-polished for the current scheme yet
+    QElapsedTimer m_openTimer;
+    qint64 m_firstOpenMs;
     QString m_currentLanguageCode;  // MOVED HERE - AFTER m_dropdownVisible
 
     std::unique_ptr<CrispCircleFlagWidget> m_currentFlag;
     std::unique_ptr<AnimatedArrowWidget> m_animatedArrow;
     std::unique_ptr<QWidget> m_dropdownWidget;
-    std::unique_ptr<QListWidget> m_languageList;
+    std::unique_ptr<QLineEdit> m_searchField;
+    std::unique_ptr<QListView> m_languageList;
+    LanguageItemDelegate *m_itemDelegate;   // owned by m_languageList
+    std::unique_ptr<FrostedBackdrop> m_dropdownBackdrop;
     std::unique_ptr<GeolocationService> m_geolocationService;
 };
 
 // WelcomeCard - Main welcome interface card
+//
+// The parts that never animate (background, border, panda, title, subtitle
+// and the auto-translate note) are rasterized once into a device-pixel
+// layer. Those widgets keep their place in the layout but stay hidden, so a
+// repaint anywhere in the card is a blit of the dirty rects from the layer,
+// with only the dynamic children (window buttons, continue button,
+// dropdown) painting over it. The layer is rebuilt when a static widget
+// moves, resizes or restyles, on retranslation and on a DPR change.
 class WelcomeCard : public QFrame
 {
     Q_OBJECT
@@ -256,22 +352,30 @@ class WelcomeCard : public QFrame
 public:
     explicit WelcomeCard(QWidget *parent = nullptr);
 
-    void setDarkMode(bool enabled);
+    // Re-colours the card and its dropdown from Theme; nothing is rebuilt
+    void applyTheme();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
     void onLanguageChanged(const QString &languageCode);
+    void invalidateStaticLayer();
 
 private:
     void setupUI();
     void setupWindowControls();
     void updateLanguage(const QString &languageCode);
     void adjustLayout();
+    void addToStaticLayer(QWidget *widget);
+    void updateAccessibleText();
+    void rebuildStaticLayer(qreal devicePixelRatio);
 
-    bool m_darkMode;
+    QList<QPointer<QWidget>> m_staticWidgets;
+    QPixmap m_staticLayer;
+    bool m_renderingStaticLayer;
 
     // Window controls
     std::unique_ptr<WindowControlButton> m_minimizeButton;
@@ -300,6 +404,9 @@ public slots:
     void onCloseClicked();
     void onContinueClicked();
 
+private slots:
+    void applyTheme();
+
 protected:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
@@ -0,0 +1,165 @@
+#include "networkservice.h"
+#include "config.h"
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QSslConfiguration>
+#include <QSslSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+// NetworkWorker - Runs entirely on the network I/O thread
+NetworkWorker::NetworkWorker(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(nullptr)
+{
+}
+
+QNetworkAccessManager *NetworkWorker::networkManager()
+{
+    // Created lazily so it is born on the I/O thread
+    if (!m_networkManager) {
+        m_networkManager = new QNetworkAccessManager(this);
+    }
+    return m_networkManager;
+}
+
+void NetworkWorker::preconnect(const QList<QUrl> &hosts)
+{
+    for (const QUrl &url : hosts) {
+        if (url.scheme() == "https" && QSslSocket::supportsSsl()) {
+            // Offer h2 so the warmed connection is the one flag requests multiplex over
+            QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+            sslConfig.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2,
+                                               QSslConfiguration::NextProtocolHttp1_1});
+            networkManager()->connectToHostEncrypted(url.host(), url.port(443), sslConfig);
+        } else if (url.scheme() == "http") {
+            networkManager()->connectToHost(url.host(), url.port(80));
+        }
+    }
+}
+
+void NetworkWorker::fetchFlag(const QString &flagUrl, const QByteArray &etag,
+                              const QByteArray &lastModified, bool highPriority)
+{
+    QNetworkRequest request{QUrl(flagUrl)};
+    request.setHeader(QNetworkRequest::UserAgentHeader, "PandaBlur/1.0");
+    request.setRawHeader("Accept", "image/svg+xml,image/*");
+    request.setTransferTimeout(Config::NETWORK_TIMEOUT_MS);
+    request.setPriority(highPriority ? QNetworkRequest::HighPriority : QNetworkRequest::NormalPriority);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (!etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", etag);
+    }
+    if (!lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", lastModified);
+    }
+
+    QNetworkReply *reply = networkManager()->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, flagUrl]() {
+        reply->deleteLater();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            emit flagFetchFailed(flagUrl, reply->errorString());
+            return;
+        }
+
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        emit flagFetched(flagUrl, status, reply->readAll(),
+                         reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"));
+    });
+}
+
+void NetworkWorker::fetchGeolocation()
+{
+    QNetworkRequest request{QUrl(Config::GEOLOCATION_URL)};
+    request.setHeader(QNetworkRequest::UserAgentHeader, "PandaBlur/1.0");
+    request.setRawHeader("Accept", "application/json");
+    request.setTransferTimeout(Config::NETWORK_TIMEOUT_MS);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    QNetworkReply *reply = networkManager()->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            emit geolocationFailed(reply->errorString());
+            return;
+        }
+
+        const QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+        const QString countryCode = obj["country_code"].toString().toLower();
+        if (countryCode.isEmpty()) {
+            emit geolocationFailed("Response did not contain a country code");
+            return;
+        }
+        emit geolocationResolved(countryCode);
+    });
+}
+
+// NetworkService - Owned by the application object; the I/O thread stops on aboutToQuit
+NetworkService& NetworkService::instance()
+{
+    static NetworkService *instance = new NetworkService(QCoreApplication::instance());
+    return *instance;
+}
+
+NetworkService::NetworkService(QObject *parent)
+    : QObject(parent)
+    , m_worker(new NetworkWorker())
+{
+    m_thread.setObjectName("PandaBlur network I/O");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+
+    // Cross-thread connections are queued automatically
+    connect(m_worker, &NetworkWorker::flagFetched, this, &NetworkService::flagFetched);
+    connect(m_worker, &NetworkWorker::flagFetchFailed, this, &NetworkService::flagFetchFailed);
+    connect(m_worker, &NetworkWorker::geolocationResolved, this, &NetworkService::geolocationResolved);
+    connect(m_worker, &NetworkWorker::geolocationFailed, this, &NetworkService::geolocationFailed);
+
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &NetworkService::shutdown);
+
+    m_thread.start();
+}
+
+NetworkService::~NetworkService()
+{
+    shutdown();
+}
+
+void NetworkService::shutdown()
+{
+    if (!m_thread.isRunning()) return;
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void NetworkService::preconnect(const QList<QUrl> &hosts)
+{
+    if (!m_thread.isRunning()) return;
+
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, hosts]() {
+        worker->preconnect(hosts);
+    }, Qt::QueuedConnection);
+}
+
+void NetworkService::fetchFlag(const QString &flagUrl, const QByteArray &etag,
+                               const QByteArray &lastModified, bool highPriority)
+{
+    if (!m_thread.isRunning()) return;
+
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, flagUrl, etag, lastModified, highPriority]() {
+        worker->fetchFlag(flagUrl, etag, lastModified, highPriority);
+    }, Qt::QueuedConnection);
+}
+
+void NetworkService::fetchGeolocation()
+{
+    if (!m_thread.isRunning()) return;
+
+    QMetaObject::invokeMethod(m_worker, &NetworkWorker::fetchGeolocation, Qt::QueuedConnection);
+}
@@ -0,0 +1,85 @@
+#ifndef NETWORKSERVICE_H
+#define NETWORKSERVICE_H
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QUrl>
+
+QT_BEGIN_NAMESPACE
+class QNetworkAccessManager;
+QT_END_NAMESPACE
+
+// NetworkWorker - Lives on the network I/O thread and owns the only access manager
+//
+// Replies are read and parsed here; only plain values (status codes, SVG
+// bytes, country codes) cross back to the GUI thread.
+class NetworkWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit NetworkWorker(QObject *parent = nullptr);
+
+public slots:
+    void preconnect(const QList<QUrl> &hosts);
+    void fetchFlag(const QString &flagUrl, const QByteArray &etag,
+                   const QByteArray &lastModified, bool highPriority);
+    void fetchGeolocation();
+
+signals:
+    void flagFetched(const QString &flagUrl, int statusCode, const QByteArray &svgData,
+                     const QByteArray &etag, const QByteArray &lastModified);
+    void flagFetchFailed(const QString &flagUrl, const QString &error);
+    void geolocationResolved(const QString &countryCode);
+    void geolocationFailed(const QString &error);
+
+private:
+    QNetworkAccessManager *networkManager();
+
+    QNetworkAccessManager *m_networkManager;
+};
+
+// NetworkService - GUI-side facade for the network I/O thread
+//
+// All HTTP traffic in the application goes through here. Requests are
+// queued to NetworkWorker and results come back as queued signals, so the
+// GUI thread never touches a QNetworkReply.
+//
+// preconnect() opens the TCP/TLS connections to known hosts before the
+// first request needs them. HTTPS hosts negotiate HTTP/2, so every flag
+// download shares one multiplexed connection instead of a pool of six.
+class NetworkService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static NetworkService& instance();
+    ~NetworkService();
+
+    void preconnect(const QList<QUrl> &hosts);
+    void fetchFlag(const QString &flagUrl, const QByteArray &etag = QByteArray(),
+                   const QByteArray &lastModified = QByteArray(), bool highPriority = false);
+    void fetchGeolocation();
+
+signals:
+    void flagFetched(const QString &flagUrl, int statusCode, const QByteArray &svgData,
+                     const QByteArray &etag, const QByteArray &lastModified);
+    void flagFetchFailed(const QString &flagUrl, const QString &error);
+    void geolocationResolved(const QString &countryCode);
+    void geolocationFailed(const QString &error);
+
+private:
+    explicit NetworkService(QObject *parent = nullptr);
+    NetworkService(const NetworkService&) = delete;
+    NetworkService& operator=(const NetworkService&) = delete;
+
+    void shutdown();
+
+    QThread m_thread;
+    NetworkWorker *m_worker;
+};
+
+#endif // NETWORKSERVICE_H
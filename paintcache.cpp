@@ -0,0 +1,71 @@
+#include "paintcache.h"
+#include "config.h"
+#include "flagrastercache.h"
+#include <QCoreApplication>
+#include <QImage>
+#include <QPainter>
+#include <QTransform>
+#include <algorithm>
+
+namespace {
+    constexpr int MAX_STATIC_TEXTS = 256;
+}
+
+// PaintCache - Owned by the application object so no pixmap outlives QApplication
+PaintCache& PaintCache::instance()
+{
+    static PaintCache *instance = new PaintCache(QCoreApplication::instance());
+    return *instance;
+}
+
+PaintCache::PaintCache(QObject *parent)
+    : QObject(parent)
+    , m_states(Config::PAINT_CACHE_KB)
+    , m_texts(MAX_STATIC_TEXTS)
+{
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_states.clear();
+        m_texts.clear();
+    });
+}
+
+QPixmap PaintCache::state(const QString &key, const QSize &logicalSize, qreal devicePixelRatio,
+                          const PaintFunction &paint)
+{
+    const QString cacheKey = QString("%1@%2x%3@%4").arg(key).arg(logicalSize.width())
+                                 .arg(logicalSize.height()).arg(qRound(devicePixelRatio * 100));
+    if (QPixmap *cached = m_states.object(cacheKey)) return *cached;
+
+    const QSize deviceSize = FlagRasterCache::devicePixelSize(logicalSize, devicePixelRatio);
+    if (deviceSize.isEmpty()) return QPixmap();
+
+    QImage image(deviceSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    image.setDevicePixelRatio(devicePixelRatio);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        paint(&painter, logicalSize);
+    }
+
+    QPixmap pixmap = QPixmap::fromImage(std::move(image));
+    const qsizetype costKb = std::max<qsizetype>(1, qsizetype(deviceSize.width()) * deviceSize.height() * 4 / 1024);
+    m_states.insert(cacheKey, new QPixmap(pixmap), costKb);
+    return pixmap;
+}
+
+QStaticText PaintCache::staticText(const QString &text, const QFont &font)
+{
+    const QString cacheKey = font.key() + QLatin1Char('\n') + text;
+    if (QStaticText *cached = m_texts.object(cacheKey)) return *cached;
+
+    // Laid out once; drawStaticText() only re-lays it out if the painter font or scale differs
+    auto *staticText = new QStaticText(text);
+    staticText->setTextFormat(Qt::PlainText);
+    staticText->setPerformanceHint(QStaticText::AggressiveCaching);
+    staticText->prepare(QTransform(), font);
+    const QStaticText result = *staticText;
+    m_texts.insert(cacheKey, staticText);
+    return result;
+}
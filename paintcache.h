@@ -0,0 +1,55 @@
+#ifndef PAINTCACHE_H
+#define PAINTCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QFont>
+#include <QPixmap>
+#include <QSize>
+#include <QStaticText>
+#include <QString>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+
+// PaintCache - Pre-rendered control states and laid-out text
+//
+// Custom-painted controls describe each visual state with a key such as
+// "window-control/close.svg/hover" or "language-list/check" and a function
+// that paints it. The first request renders it once at the exact device pixel
+// size; every later paint of that state is a 1:1 blit. States are keyed by
+// (key, logical size, DPR) and charged against Config::PAINT_CACHE_KB. A
+// key must always describe the same picture; anything that changes it
+// (hover, theme, icon) belongs in the key. Meant for small control states:
+// anything window-sized belongs in the owning widget's own layer.
+//
+// Text that changes independently of the state image is drawn from a
+// QStaticText laid out once per (text, font). Owned by the application
+// object and emptied on aboutToQuit.
+class PaintCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    using PaintFunction = std::function<void(QPainter *painter, const QSize &logicalSize)>;
+
+    static PaintCache& instance();
+
+    // The painter passed to paint() works in logical pixels and has antialiasing on
+    QPixmap state(const QString &key, const QSize &logicalSize, qreal devicePixelRatio,
+                  const PaintFunction &paint);
+
+    QStaticText staticText(const QString &text, const QFont &font);
+
+private:
+    explicit PaintCache(QObject *parent = nullptr);
+    PaintCache(const PaintCache&) = delete;
+    PaintCache& operator=(const PaintCache&) = delete;
+
+    QCache<QString, QPixmap> m_states;
+    QCache<QString, QStaticText> m_texts;
+};
+
+#endif // PAINTCACHE_H
@@ -0,0 +1,85 @@
+#include "paintstats.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QPaintEvent>
+#include <QTimer>
+#include <QWidget>
+
+// PaintStats - Owned by the application object
+PaintStats& PaintStats::instance()
+{
+    static PaintStats *instance = new PaintStats(QCoreApplication::instance());
+    return *instance;
+}
+
+bool PaintStats::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("PANDABLUR_PAINT_STATS") != 0;
+    return enabled;
+}
+
+PaintStats::PaintStats(QObject *parent)
+    : QObject(parent)
+    , m_installed(false)
+    , m_updateOpen(false)
+    , m_pendingPixels(0)
+    , m_pendingWidgets(0)
+    , m_largestPixels(0)
+    , m_lastUpdatePixels(0)
+    , m_totalPixels(0)
+    , m_updates(0)
+{
+}
+
+void PaintStats::install()
+{
+    if (m_installed || !isEnabled()) return;
+    m_installed = true;
+
+    QCoreApplication::instance()->installEventFilter(this);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        qDebug() << "PaintStats:" << m_updates << "updates," << m_totalPixels << "px repainted,"
+                 << (m_updates ? m_totalPixels / m_updates : 0) << "px per update";
+    });
+}
+
+bool PaintStats::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint && watched->isWidgetType()) {
+        qint64 pixels = 0;
+        for (const QRect &rect : static_cast<QPaintEvent *>(event)->region()) {
+            pixels += qint64(rect.width()) * rect.height();
+        }
+
+        m_pendingPixels += pixels;
+        ++m_pendingWidgets;
+        if (pixels > m_largestPixels) {
+            m_largestPixels = pixels;
+            m_largestWidget = watched->objectName().isEmpty()
+                                  ? QString::fromLatin1(watched->metaObject()->className())
+                                  : watched->objectName();
+        }
+
+        if (!m_updateOpen) {
+            m_updateOpen = true;
+            QTimer::singleShot(0, this, &PaintStats::finishUpdate);
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void PaintStats::finishUpdate()
+{
+    ++m_updates;
+    m_lastUpdatePixels = m_pendingPixels;
+    m_totalPixels += m_pendingPixels;
+
+    qDebug() << "PaintStats: update" << m_updates << "repainted" << m_pendingPixels << "px in"
+             << m_pendingWidgets << "widgets, most in" << m_largestWidget << "(" << m_largestPixels << "px)";
+
+    m_updateOpen = false;
+    m_pendingPixels = 0;
+    m_pendingWidgets = 0;
+    m_largestPixels = 0;
+    m_largestWidget.clear();
+}
@@ -0,0 +1,51 @@
+#ifndef PAINTSTATS_H
+#define PAINTSTATS_H
+
+#include <QObject>
+#include <QString>
+
+// PaintStats - Counts how many pixels each screen update repaints
+//
+// Enabled by setting PANDABLUR_PAINT_STATS=1. An application-wide event
+// filter adds up the area of every paint event's region. Qt paints all
+// dirty widgets in one pass, so the next turn of the event loop closes the
+// update and logs one line with the total, the widget count and the widget
+// that repainted the most. Areas are logical pixels. A summary is logged
+// on aboutToQuit. When disabled nothing is installed.
+class PaintStats : public QObject
+{
+    Q_OBJECT
+
+public:
+    static PaintStats& instance();
+    static bool isEnabled();
+
+    // Installs the event filter if enabled; call once the QApplication exists
+    void install();
+
+    qint64 lastUpdatePixels() const { return m_lastUpdatePixels; }
+    qint64 totalPixels() const { return m_totalPixels; }
+    int updates() const { return m_updates; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit PaintStats(QObject *parent = nullptr);
+    PaintStats(const PaintStats&) = delete;
+    PaintStats& operator=(const PaintStats&) = delete;
+
+    void finishUpdate();
+
+    bool m_installed;
+    bool m_updateOpen;
+    qint64 m_pendingPixels;
+    int m_pendingWidgets;
+    qint64 m_largestPixels;
+    QString m_largestWidget;
+    qint64 m_lastUpdatePixels;
+    qint64 m_totalPixels;
+    int m_updates;
+};
+
+#endif // PAINTSTATS_H
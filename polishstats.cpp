@@ -0,0 +1,48 @@
+#include "polishstats.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+
+// PolishStats - Owned by the application object
+PolishStats& PolishStats::instance()
+{
+    static PolishStats *instance = new PolishStats(QCoreApplication::instance());
+    return *instance;
+}
+
+PolishStats::PolishStats(QObject *parent)
+    : QObject(parent)
+    , m_installed(false)
+    , m_polishes(0)
+    , m_styleChanges(0)
+{
+}
+
+void PolishStats::install()
+{
+    if (m_installed) return;
+    m_installed = true;
+
+    QCoreApplication::instance()->installEventFilter(this);
+}
+
+void PolishStats::finishStartup()
+{
+    if (!m_installed) return;
+    m_installed = false;
+
+    QCoreApplication::instance()->removeEventFilter(this);
+    qDebug() << "Startup:" << m_polishes << "widget polishes," << m_styleChanges << "style changes";
+}
+
+bool PolishStats::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched->isWidgetType()) {
+        if (event->type() == QEvent::Polish) {
+            ++m_polishes;
+        } else if (event->type() == QEvent::StyleChange) {
+            ++m_styleChanges;
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
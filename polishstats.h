@@ -0,0 +1,39 @@
+#ifndef POLISHSTATS_H
+#define POLISHSTATS_H
+
+#include <QObject>
+
+// PolishStats - Counts widget polishes and style changes during startup
+//
+// An application-wide event filter counts QEvent::Polish (a widget is
+// polished for the first time) and QEvent::StyleChange (a polished widget
+// is restyled, e.g. by setStyleSheet) from install() until finishStartup(),
+// which logs both numbers and removes the filter.
+class PolishStats : public QObject
+{
+    Q_OBJECT
+
+public:
+    static PolishStats& instance();
+
+    // Call once the QApplication exists, before any widget is created
+    void install();
+    void finishStartup();
+
+    int polishes() const { return m_polishes; }
+    int styleChanges() const { return m_styleChanges; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit PolishStats(QObject *parent = nullptr);
+    PolishStats(const PolishStats&) = delete;
+    PolishStats& operator=(const PolishStats&) = delete;
+
+    bool m_installed;
+    int m_polishes;
+    int m_styleChanges;
+};
+
+#endif // POLISHSTATS_H
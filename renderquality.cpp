@@ -0,0 +1,160 @@
+#include "renderquality.h"
+#include "config.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QWidget>
+#include <algorithm>
+#include <cmath>
+
+// RenderQuality - Owned by the application object
+RenderQuality& RenderQuality::instance()
+{
+    static RenderQuality *instance = new RenderQuality(QCoreApplication::instance());
+    return *instance;
+}
+
+RenderQuality::RenderQuality(QObject *parent)
+    : QObject(parent)
+    , m_tier(Tier::Full)
+    , m_overridden(false)
+{
+    m_probeTimer.setInterval(Config::QUALITY_PROBE_INTERVAL_MS);
+    connect(&m_probeTimer, &QTimer::timeout, this, &RenderQuality::takeSample);
+
+    const QString environment = qEnvironmentVariable("PANDABLUR_QUALITY");
+    if (!environment.isEmpty() && !setOverride(environment)) {
+        qWarning() << "Ignoring unknown PANDABLUR_QUALITY:" << environment;
+    }
+}
+
+bool RenderQuality::parseTier(const QString &name, Tier *tier)
+{
+    const QString key = name.trimmed().toLower();
+    if (key == "full") {
+        *tier = Tier::Full;
+    } else if (key == "reduced") {
+        *tier = Tier::Reduced;
+    } else if (key == "minimal") {
+        *tier = Tier::Minimal;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+QString RenderQuality::tierName(Tier tier)
+{
+    switch (tier) {
+    case Tier::Reduced: return "reduced";
+    case Tier::Minimal: return "minimal";
+    case Tier::Full: break;
+    }
+    return "full";
+}
+
+bool RenderQuality::setOverride(const QString &name)
+{
+    if (name.trimmed().compare("auto", Qt::CaseInsensitive) == 0) {
+        // The probe only ever lowers the tier, so it has to start from full again
+        m_overridden = false;
+        setTier(Tier::Full);
+        return true;
+    }
+
+    Tier tier;
+    if (!parseTier(name, &tier)) return false;
+
+    m_overridden = true;
+    m_probeTimer.stop();
+    m_samples.clear();
+    setTier(tier);
+    return true;
+}
+
+void RenderQuality::startProbe(QWidget *window)
+{
+    if (m_overridden || !window) return;
+
+    m_probeTarget = window;
+    m_samples.clear();
+    m_probeTimer.start();
+}
+
+void RenderQuality::takeSample()
+{
+    if (!m_probeTarget) {
+        m_probeTimer.stop();
+        return;
+    }
+    // A hidden or minimized window paints nothing worth measuring
+    if (!m_probeTarget->isVisible() || m_probeTarget->isMinimized()) return;
+
+    // repaint() paints and flushes synchronously, the same work as one animation frame
+    QElapsedTimer timer;
+    timer.start();
+    m_probeTarget->repaint();
+    m_samples.append(timer.nsecsElapsed() / 1e6);
+
+    if (m_samples.size() >= Config::QUALITY_PROBE_SAMPLES) {
+        finishProbe();
+    }
+}
+
+void RenderQuality::finishProbe()
+{
+    m_probeTimer.stop();
+    if (m_samples.isEmpty()) return;
+
+    // The median ignores the first paint, which also builds every cache
+    QList<double> sorted = m_samples;
+    std::sort(sorted.begin(), sorted.end());
+    const double median = sorted.at(sorted.size() / 2);
+
+    Tier measured = Tier::Full;
+    if (median > Config::QUALITY_MINIMAL_FRAME_MS) {
+        measured = Tier::Minimal;
+    } else if (median > Config::QUALITY_REDUCED_FRAME_MS) {
+        measured = Tier::Reduced;
+    }
+
+    qDebug() << "RenderQuality: median repaint" << median << "ms over" << sorted.size()
+             << "samples, tier" << tierName(std::max(measured, m_tier));
+    setTier(std::max(measured, m_tier));
+}
+
+void RenderQuality::setTier(Tier tier)
+{
+    if (tier == m_tier) return;
+
+    m_tier = tier;
+    emit tierChanged(tier);
+}
+
+int RenderQuality::shadowBlurRadius(int fullRadius) const
+{
+    switch (m_tier) {
+    case Tier::Reduced: return std::max(1, fullRadius / 2);
+    case Tier::Minimal: return 0;
+    case Tier::Full: break;
+    }
+    return fullRadius;
+}
+
+int RenderQuality::animationDuration(int fullMs) const
+{
+    switch (m_tier) {
+    case Tier::Reduced: return fullMs / 2;
+    case Tier::Minimal: return 0;
+    case Tier::Full: break;
+    }
+    return fullMs;
+}
+
+int RenderQuality::flagRenderScale(qreal devicePixelRatio) const
+{
+    // Full supersamples at twice the DPR; the lower tiers render at device resolution
+    const qreal scale = m_tier == Tier::Full ? devicePixelRatio * 2 : std::ceil(devicePixelRatio);
+    return static_cast<int>(std::clamp(scale,
+                                       static_cast<qreal>(Config::MIN_RENDER_SCALE),
+                                       static_cast<qreal>(Config::MAX_RENDER_SCALE)));
+}
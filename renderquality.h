@@ -0,0 +1,77 @@
+#ifndef RENDERQUALITY_H
+#define RENDERQUALITY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QWidget;
+QT_END_NAMESPACE
+
+// RenderQuality - Rendering quality tier for the whole application
+//
+//   full     - blurred shadows, frosted dropdown backdrop, full-length
+//              animations, flags supersampled up to Config::MAX_RENDER_SCALE
+//   reduced  - half-radius shadows, no backdrop blur, half-length
+//              animations, flags rendered at device resolution
+//   minimal  - no shadows, no backdrop blur, no animations, flags at
+//              device resolution
+//
+// Unless overridden, the tier starts at full and startProbe() times
+// Config::QUALITY_PROBE_SAMPLES synchronous repaints of the main window
+// during the first seconds. A median above Config::QUALITY_REDUCED_FRAME_MS
+// or Config::QUALITY_MINIMAL_FRAME_MS lowers the tier; the probe never
+// raises it. PANDABLUR_QUALITY or --quality=<tier> (which wins) pins the
+// tier and skips the probe; "auto" restores the measurement.
+class RenderQuality : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Tier { Full, Reduced, Minimal };
+    Q_ENUM(Tier)
+
+    static RenderQuality& instance();
+
+    static bool parseTier(const QString &name, Tier *tier);
+    static QString tierName(Tier tier);
+
+    Tier tier() const { return m_tier; }
+    bool isOverridden() const { return m_overridden; }
+
+    // "full", "reduced", "minimal" or "auto"; false for anything else
+    bool setOverride(const QString &name);
+
+    // Measures repaints of window unless the tier is overridden
+    void startProbe(QWidget *window);
+
+    bool shadowsEnabled() const { return m_tier != Tier::Minimal; }
+    int shadowBlurRadius(int fullRadius) const;
+    bool frostedBackdropEnabled() const { return m_tier == Tier::Full; }
+    int animationDuration(int fullMs) const;
+    int flagRenderScale(qreal devicePixelRatio) const;
+
+signals:
+    void tierChanged(RenderQuality::Tier tier);
+
+private:
+    explicit RenderQuality(QObject *parent = nullptr);
+    RenderQuality(const RenderQuality&) = delete;
+    RenderQuality& operator=(const RenderQuality&) = delete;
+
+    void setTier(Tier tier);
+    void takeSample();
+    void finishProbe();
+
+    Tier m_tier;
+    bool m_overridden;
+    QPointer<QWidget> m_probeTarget;
+    QTimer m_probeTimer;
+    QList<double> m_samples;
+};
+
+#endif // RENDERQUALITY_H
@@ -0,0 +1,173 @@
+#include "svgassetregistry.h"
+#include "flagrastercache.h"
+#include "config.h"
+#include "iconpainter.h"
+#include "generatedicons.h"
+#include "assetpack.h"
+#include <QCoreApplication>
+#include <QSvgRenderer>
+#include <QPainter>
+#include <QImage>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+// SvgAssetRegistry - Owned by the application object so no pixmap outlives QApplication
+SvgAssetRegistry& SvgAssetRegistry::instance()
+{
+    static SvgAssetRegistry *instance = new SvgAssetRegistry(QCoreApplication::instance());
+    return *instance;
+}
+
+SvgAssetRegistry::SvgAssetRegistry(QObject *parent)
+    : QObject(parent)
+    , m_rasters(Config::SVG_RASTER_CACHE_KB)
+{
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        m_rasters.clear();
+    });
+}
+
+const IconData::Icon *SvgAssetRegistry::builtinIcon(const QString &name)
+{
+    // ":/check.svg" and "check.svg" name the same compiled-in icon
+    return GeneratedIcons::find(name.startsWith(":/") ? QStringView(name).mid(2) : QStringView(name));
+}
+
+bool SvgAssetRegistry::hasAsset(const QString &name)
+{
+    return builtinIcon(name) || renderer(name);
+}
+
+QString SvgAssetRegistry::resolve(const QString &name)
+{
+    auto it = m_paths.constFind(name);
+    if (it != m_paths.constEnd()) return it.value();
+
+    // Same lookup order the widgets used to probe individually
+    QStringList candidates = {name};
+    if (!name.startsWith(":/")) {
+        candidates << QCoreApplication::applicationDirPath() + "/" + name
+                   << QDir::currentPath() + "/" + name
+                   << ":/" + name;
+    }
+
+    QString resolved;
+    for (const QString &path : candidates) {
+        if (QFile::exists(path)) {
+            resolved = path;
+            break;
+        }
+    }
+
+    if (resolved.isEmpty()) {
+        qDebug() << "SVG asset not found:" << name << "tried:" << candidates;
+    }
+    m_paths.insert(name, resolved);
+    return resolved;
+}
+
+std::shared_ptr<QSvgRenderer> SvgAssetRegistry::renderer(const QString &name)
+{
+    auto it = m_renderers.constFind(name);
+    if (it != m_renderers.constEnd()) return it.value();
+
+    // Packed assets are parsed straight out of the mapping; loose files are the fallback
+    std::shared_ptr<QSvgRenderer> svgRenderer;
+    const QByteArray packed = AssetPack::instance().data(name.startsWith(":/") ? name.mid(2) : name);
+    const QString path = packed.isEmpty() ? resolve(name) : QString();
+    if (!packed.isEmpty()) {
+        svgRenderer = std::make_shared<QSvgRenderer>(packed);
+    } else if (!path.isEmpty()) {
+        svgRenderer = std::make_shared<QSvgRenderer>(path);
+    }
+
+    if (svgRenderer && svgRenderer->isValid()) {
+        qDebug() << "Loaded SVG asset" << name << "from:" << (packed.isEmpty() ? path : Config::ASSET_PACK_FILE);
+        connect(svgRenderer.get(), &QSvgRenderer::repaintNeeded, this, [this, name]() {
+            dropRasters(name);
+            emit assetChanged(name);
+        });
+    } else if (svgRenderer) {
+        qDebug() << "Invalid SVG asset:" << name;
+        svgRenderer.reset();
+    }
+
+    // Failures are remembered too, so a missing asset is only probed once
+    m_renderers.insert(name, svgRenderer);
+    return svgRenderer;
+}
+
+QString SvgAssetRegistry::rasterKey(const QString &name, const QSize &logicalSize, qreal devicePixelRatio)
+{
+    return QString("%1@%2x%3@%4").arg(name).arg(logicalSize.width()).arg(logicalSize.height())
+        .arg(qRound(devicePixelRatio * 100));
+}
+
+bool SvgAssetRegistry::paint(QPainter *painter, const QString &name, const QRectF &target)
+{
+    if (const IconData::Icon *icon = builtinIcon(name)) {
+        IconPainter::paint(painter, *icon, target);
+        return true;
+    }
+
+    std::shared_ptr<QSvgRenderer> svgRenderer = renderer(name);
+    if (!svgRenderer) return false;
+    svgRenderer->render(painter, target);
+    return true;
+}
+
+QPixmap SvgAssetRegistry::raster(const QString &name, const QSize &logicalSize, qreal devicePixelRatio)
+{
+    const QString key = rasterKey(name, logicalSize, devicePixelRatio);
+    if (QPixmap *cached = m_rasters.object(key)) return *cached;
+
+    const IconData::Icon *icon = builtinIcon(name);
+    std::shared_ptr<QSvgRenderer> svgRenderer = icon ? nullptr : renderer(name);
+    const QSize deviceSize = FlagRasterCache::devicePixelSize(logicalSize, devicePixelRatio);
+    if ((!icon && !svgRenderer) || deviceSize.isEmpty()) return QPixmap();
+
+    QImage image(deviceSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    // Fit and center in device pixels so the result is blitted without resampling
+    QRectF targetRect(QPointF(0, 0), deviceSize);
+    const QSizeF naturalSize = icon ? IconPainter::defaultSize(*icon) : QSizeF(svgRenderer->defaultSize());
+    if (!naturalSize.isEmpty()) {
+        const qreal scale = std::min(targetRect.width() / naturalSize.width(),
+                                     targetRect.height() / naturalSize.height());
+        const QSizeF scaledSize = naturalSize * scale;
+        targetRect = QRectF(QPointF(std::floor((deviceSize.width() - scaledSize.width()) / 2),
+                                    std::floor((deviceSize.height() - scaledSize.height()) / 2)),
+                            scaledSize);
+    }
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    if (icon) {
+        IconPainter::paint(&painter, *icon, targetRect);
+    } else {
+        svgRenderer->render(&painter, targetRect);
+    }
+    painter.end();
+
+    QPixmap pixmap = QPixmap::fromImage(std::move(image));
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    const qsizetype costKb = std::max<qsizetype>(1, qsizetype(deviceSize.width()) * deviceSize.height() * 4 / 1024);
+    m_rasters.insert(key, new QPixmap(pixmap), costKb);
+    return pixmap;
+}
+
+void SvgAssetRegistry::dropRasters(const QString &name)
+{
+    const QString prefix = name + "@";
+    const QList<QString> keys = m_rasters.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith(prefix)) {
+            m_rasters.remove(key);
+        }
+    }
+}
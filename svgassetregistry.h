@@ -0,0 +1,73 @@
+#ifndef SVGASSETREGISTRY_H
+#define SVGASSETREGISTRY_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QString>
+#include <QSize>
+#include <QPixmap>
+#include <QRectF>
+#include <memory>
+#include "icondata.h"
+
+QT_BEGIN_NAMESPACE
+class QSvgRenderer;
+class QPainter;
+QT_END_NAMESPACE
+
+// SvgAssetRegistry - Resolves, parses and rasterizes each SVG asset once per process
+//
+// Widgets ask for a logical asset name ("panda.svg", "check.svg"). Icons
+// compiled in by svg2cpp are served from GeneratedIcons and never touch the
+// file system or QtSvg. Anything else is read from AssetPack or, failing
+// that, resolved on disk, and parsed on first request; every later request for the same name gets the same shared
+// renderer with no file I/O or XML parsing. Rasters are keyed by (name, logical size,
+// device pixel ratio), so identical widgets such as the dropdown
+// checkmarks share one pixmap, and are charged against
+// Config::SVG_RASTER_CACHE_KB so resizing does not accumulate stale sizes.
+//
+// The registry is a child of the application object and drops its rasters
+// on aboutToQuit.
+class SvgAssetRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SvgAssetRegistry& instance();
+
+    // Compiled-in icon for an asset name, null if it has to come from a file
+    static const IconData::Icon *builtinIcon(const QString &name);
+
+    bool hasAsset(const QString &name);
+
+    // Empty if the asset could not be found in any candidate location
+    QString resolve(const QString &name);
+
+    // Null if the asset is missing or not a valid SVG
+    std::shared_ptr<QSvgRenderer> renderer(const QString &name);
+
+    // Stretches the asset over target; false if the asset is unavailable
+    bool paint(QPainter *painter, const QString &name, const QRectF &target);
+
+    // Aspect-fitted, centered and exactly device-pixel sized
+    QPixmap raster(const QString &name, const QSize &logicalSize, qreal devicePixelRatio);
+
+signals:
+    // A file-backed asset was reloaded or advanced an animation frame
+    void assetChanged(const QString &name);
+
+private:
+    explicit SvgAssetRegistry(QObject *parent = nullptr);
+    SvgAssetRegistry(const SvgAssetRegistry&) = delete;
+    SvgAssetRegistry& operator=(const SvgAssetRegistry&) = delete;
+
+    static QString rasterKey(const QString &name, const QSize &logicalSize, qreal devicePixelRatio);
+    void dropRasters(const QString &name);
+
+    QHash<QString, QString> m_paths;                             // name -> resolved path
+    QHash<QString, std::shared_ptr<QSvgRenderer>> m_renderers;   // name -> renderer (null if invalid)
+    QCache<QString, QPixmap> m_rasters;
+};
+
+#endif // SVGASSETREGISTRY_H
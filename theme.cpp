@@ -0,0 +1,93 @@
+#include "theme.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QStyleHints>
+#include <iterator>
+
+namespace {
+    // Indexed by Theme::Token
+    constexpr QRgb LIGHT[] = {
+        qRgb(255, 255, 255),        // CardBackground
+        qRgb(224, 224, 224),        // CardBorder
+        qRgb(0, 0, 0),              // TitleText
+        qRgb(90, 108, 125),         // SubtitleText
+        qRgb(136, 136, 136),        // CaptionText
+        qRgb(255, 255, 255),        // ControlBackground
+        qRgba(230, 230, 230, 180),  // ControlBorder
+        qRgb(26, 26, 26),           // ControlText
+        qRgb(26, 26, 26),           // ListText
+        qRgb(255, 255, 255),        // PopupFallback
+    };
+
+    constexpr QRgb DARK[] = {
+        qRgb(43, 43, 43),           // CardBackground
+        qRgb(85, 85, 85),           // CardBorder
+        qRgb(255, 255, 255),        // TitleText
+        qRgb(204, 204, 204),        // SubtitleText
+        qRgb(153, 153, 153),        // CaptionText
+        qRgb(58, 58, 58),           // ControlBackground
+        qRgba(85, 85, 85, 180),     // ControlBorder
+        qRgb(255, 255, 255),        // ControlText
+        qRgb(255, 255, 255),        // ListText
+        qRgb(45, 45, 45),           // PopupFallback
+    };
+
+    static_assert(std::size(LIGHT) == std::size_t(Theme::Token::PopupFallback) + 1, "one light colour per token");
+    static_assert(std::size(DARK) == std::size(LIGHT), "one dark colour per token");
+}
+
+// Theme - Owned by the application object
+Theme& Theme::instance()
+{
+    static Theme *instance = new Theme(QCoreApplication::instance());
+    return *instance;
+}
+
+Theme::Theme(QObject *parent)
+    : QObject(parent)
+    , m_scheme(Scheme::Light)
+    , m_followSystem(false)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, this, [this]() {
+        if (m_followSystem) applySystemScheme();
+    });
+#endif
+}
+
+QColor Theme::color(Scheme scheme, Token token)
+{
+    const QRgb *colors = scheme == Scheme::Dark ? DARK : LIGHT;
+    return QColor::fromRgba(colors[int(token)]);
+}
+
+QString Theme::schemeName(Scheme scheme)
+{
+    return scheme == Scheme::Dark ? "dark" : "light";
+}
+
+void Theme::setScheme(Scheme scheme)
+{
+    if (scheme == m_scheme) return;
+
+    m_scheme = scheme;
+    emit schemeChanged(scheme);
+}
+
+void Theme::setFollowSystem(bool follow)
+{
+    m_followSystem = follow;
+    if (follow) applySystemScheme();
+}
+
+void Theme::applySystemScheme()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    // Unknown (no platform preference) keeps the current scheme
+    switch (QGuiApplication::styleHints()->colorScheme()) {
+    case Qt::ColorScheme::Dark: setScheme(Scheme::Dark); break;
+    case Qt::ColorScheme::Light: setScheme(Scheme::Light); break;
+    default: break;
+    }
+#endif
+}
@@ -0,0 +1,71 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <QObject>
+#include <QColor>
+#include <QString>
+
+// Theme - Named colour tokens for the light and dark schemes
+//
+// Widgets never hard-code a themed colour: they ask for a token. Small
+// cached control states put stateKey() into their PaintCache key so a
+// scheme never shows the other's picture; window-sized surfaces such as the
+// card are repainted into their own layer from the tokens instead. A scheme
+// change only emits schemeChanged(); MainWindow applies it to the widget
+// tree in one batched repaint. Nothing is rebuilt, re-parsed or fetched.
+//
+// With setFollowSystem(true) the scheme tracks the platform colour scheme
+// (Qt 6.5 and later; older Qt keeps the scheme it was given).
+class Theme : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Scheme { Light, Dark };
+    Q_ENUM(Scheme)
+
+    enum class Token {
+        CardBackground,
+        CardBorder,
+        TitleText,
+        SubtitleText,
+        CaptionText,
+        ControlBackground,
+        ControlBorder,
+        ControlText,
+        ListText,
+        PopupFallback
+    };
+    Q_ENUM(Token)
+
+    static Theme& instance();
+
+    static QColor color(Scheme scheme, Token token);
+    static QString schemeName(Scheme scheme);
+
+    Scheme scheme() const { return m_scheme; }
+    bool isDark() const { return m_scheme == Scheme::Dark; }
+    QColor color(Token token) const { return color(m_scheme, token); }
+
+    // PaintCache key of a themed state: "<base>/light" or "<base>/dark"
+    QString stateKey(const QString &base) const { return base + '/' + schemeName(m_scheme); }
+
+    void setScheme(Scheme scheme);
+    bool followsSystem() const { return m_followSystem; }
+    void setFollowSystem(bool follow);
+
+signals:
+    void schemeChanged(Theme::Scheme scheme);
+
+private:
+    explicit Theme(QObject *parent = nullptr);
+    Theme(const Theme&) = delete;
+    Theme& operator=(const Theme&) = delete;
+
+    void applySystemScheme();
+
+    Scheme m_scheme;
+    bool m_followSystem;
+};
+
+#endif // THEME_H
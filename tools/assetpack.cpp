@@ -0,0 +1,142 @@
+// assetpack - Build-time packer for the memory-mapped asset pack
+//
+// Usage:
+//   assetpack --qrc resources.qrc --out pandablur.pack
+//
+// Every <file> listed in the .qrc is stored uncompressed. The layout is
+// documented in assetpack.h; see AssetPack for the reader. A listed file
+// that does not exist fails the build.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtEndian>
+#include "assetpack.h"
+
+namespace {
+    QTextStream &err()
+    {
+        static QTextStream stream(stderr);
+        return stream;
+    }
+
+    void appendU16(QByteArray *out, quint16 value)
+    {
+        char bytes[2];
+        qToLittleEndian(value, bytes);
+        out->append(bytes, sizeof(bytes));
+    }
+
+    void appendU32(QByteArray *out, quint32 value)
+    {
+        char bytes[4];
+        qToLittleEndian(value, bytes);
+        out->append(bytes, sizeof(bytes));
+    }
+
+    void padTo(QByteArray *out, int alignment)
+    {
+        const qsizetype remainder = out->size() % alignment;
+        if (remainder) out->append(alignment - remainder, '\0');
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"qrc", "Resource manifest listing the assets to pack.", "file"});
+    parser.addOption({"out", "Pack file to write.", "file"});
+    parser.process(app);
+
+    if (!parser.isSet("qrc") || !parser.isSet("out")) {
+        parser.showHelp(1);
+    }
+
+    const QString qrcPath = parser.value("qrc");
+    QFile qrc(qrcPath);
+    if (!qrc.open(QIODevice::ReadOnly)) {
+        err() << "assetpack: cannot open " << qrcPath << "\n";
+        return 1;
+    }
+
+    // Sorted by the UTF-8 bytes of the name, which is what the reader bisects on
+    const QDir baseDir = QFileInfo(qrcPath).absoluteDir();
+    static const QRegularExpression fileRe("<file>\\s*([^<]+?)\\s*</file>");
+    QMap<QByteArray, QString> assets;
+    bool ok = true;
+    auto it = fileRe.globalMatch(QString::fromUtf8(qrc.readAll()));
+    while (it.hasNext()) {
+        const QString name = it.next().captured(1);
+        const QString path = baseDir.filePath(name);
+        if (!QFileInfo(path).isFile()) {
+            err() << "assetpack: asset listed in " << qrcPath << " is missing: " << path << "\n";
+            ok = false;
+            continue;
+        }
+        assets.insert(name.toUtf8(), path);
+    }
+    if (!ok) {
+        return 1;
+    }
+
+    QByteArray names;
+    for (auto asset = assets.cbegin(); asset != assets.cend(); ++asset) {
+        names.append(asset.key());
+    }
+
+    const quint32 count = static_cast<quint32>(assets.size());
+    const quint32 namesOffset = AssetPack::HEADER_SIZE + count * AssetPack::ENTRY_SIZE;
+
+    // Index entries need the data offsets, so lay the data out first
+    QByteArray data;
+    data.reserve(1 << 20);
+    data.append(namesOffset + names.size(), '\0');
+    padTo(&data, AssetPack::ALIGNMENT);
+
+    QByteArray index;
+    quint32 nameOffset = namesOffset;
+    for (auto asset = assets.cbegin(); asset != assets.cend(); ++asset) {
+        QFile file(asset.value());
+        if (!file.open(QIODevice::ReadOnly)) {
+            err() << "assetpack: cannot read " << asset.value() << "\n";
+            return 1;
+        }
+        const QByteArray contents = file.readAll();
+
+        appendU32(&index, nameOffset);
+        appendU32(&index, static_cast<quint32>(asset.key().size()));
+        appendU32(&index, static_cast<quint32>(data.size()));
+        appendU32(&index, static_cast<quint32>(contents.size()));
+        nameOffset += asset.key().size();
+
+        data.append(contents);
+        padTo(&data, AssetPack::ALIGNMENT);
+    }
+
+    QByteArray header;
+    appendU32(&header, AssetPack::MAGIC);
+    appendU16(&header, AssetPack::VERSION);
+    appendU16(&header, AssetPack::ALIGNMENT);
+    appendU32(&header, count);
+    appendU32(&header, static_cast<quint32>(data.size()));
+
+    data.replace(0, header.size(), header);
+    data.replace(AssetPack::HEADER_SIZE, index.size(), index);
+    data.replace(namesOffset, names.size(), names);
+
+    QSaveFile out(parser.value("out"));
+    if (!out.open(QIODevice::WriteOnly) || out.write(data) != data.size() || !out.commit()) {
+        err() << "assetpack: cannot write " << parser.value("out") << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+// flagatlasgen - Build-time rasterizer that packs circle flags into one sprite atlas
+//
+// Usage:
+//   flagatlasgen --qrc resources.qrc --size 28 --scales 1,2,3
+//                [--extra-dir <circle-flags/flags>] --out-image atlas.png --out-index atlas.idx
+//
+// Every flags/<cc>.svg listed in the .qrc (plus every *.svg in --extra-dir)
+// is rendered at size * scale for each scale. Cells of one scale share a
+// horizontal band, so the index only needs the band offsets and the ordered
+// list of country codes; see FlagAtlas for the reader.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMap>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSvgRenderer>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr quint32 ATLAS_MAGIC = 0x50424641;  // "PBFA"
+    constexpr quint16 ATLAS_VERSION = 1;
+    constexpr int CELL_PADDING = 2;
+
+    QTextStream &err()
+    {
+        static QTextStream stream(stderr);
+        return stream;
+    }
+
+    bool collectFromQrc(const QString &qrcPath, QMap<QString, QString> *flags)
+    {
+        QFile qrc(qrcPath);
+        if (!qrc.open(QIODevice::ReadOnly)) {
+            err() << "flagatlasgen: cannot open " << qrcPath << "\n";
+            return false;
+        }
+
+        const QDir baseDir = QFileInfo(qrcPath).absoluteDir();
+        static const QRegularExpression fileRe("<file>\\s*(flags/([a-z0-9_-]+)\\.svg)\\s*</file>");
+
+        bool ok = true;
+        auto it = fileRe.globalMatch(QString::fromUtf8(qrc.readAll()));
+        while (it.hasNext()) {
+            const auto match = it.next();
+            const QString path = baseDir.filePath(match.captured(1));
+            if (!QFile::exists(path)) {
+                err() << "flagatlasgen: flag listed in " << qrcPath << " is missing: " << path << "\n";
+                ok = false;
+                continue;
+            }
+            flags->insert(match.captured(2), path);
+        }
+        return ok;
+    }
+
+    void collectFromDirectory(const QString &dirPath, QMap<QString, QString> *flags)
+    {
+        const QFileInfoList entries = QDir(dirPath).entryInfoList({"*.svg"}, QDir::Files, QDir::Name);
+        for (const QFileInfo &info : entries) {
+            // Bundled flags win over the optional full set
+            if (!flags->contains(info.baseName())) {
+                flags->insert(info.baseName(), info.absoluteFilePath());
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"qrc", "Resource file listing flags/<cc>.svg entries.", "file"});
+    parser.addOption({"extra-dir", "Optional directory with additional flag SVGs.", "dir"});
+    parser.addOption({"size", "Logical flag size in pixels.", "px", "28"});
+    parser.addOption({"scales", "Comma separated integer scales.", "list", "1,2,3"});
+    parser.addOption({"out-image", "Atlas PNG to write.", "file"});
+    parser.addOption({"out-index", "Atlas index to write.", "file"});
+    parser.process(app);
+
+    if (!parser.isSet("qrc") || !parser.isSet("out-image") || !parser.isSet("out-index")) {
+        parser.showHelp(1);
+    }
+
+    QMap<QString, QString> flags;
+    if (!collectFromQrc(parser.value("qrc"), &flags)) {
+        return 1;
+    }
+    if (parser.isSet("extra-dir") && !parser.value("extra-dir").isEmpty()) {
+        collectFromDirectory(parser.value("extra-dir"), &flags);
+    }
+    if (flags.isEmpty()) {
+        err() << "flagatlasgen: no flags to pack\n";
+        return 1;
+    }
+
+    const int flagSize = parser.value("size").toInt();
+    QList<int> scales;
+    for (const QString &part : parser.value("scales").split(',', Qt::SkipEmptyParts)) {
+        scales.append(part.toInt());
+    }
+    if (flagSize <= 0 || scales.isEmpty()) {
+        err() << "flagatlasgen: invalid --size or --scales\n";
+        return 1;
+    }
+
+    const int count = flags.size();
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const int rows = (count + columns - 1) / columns;
+    const int maxScale = *std::max_element(scales.begin(), scales.end());
+
+    // One band per scale, stacked vertically
+    QList<int> bandOffsets;
+    int atlasHeight = 0;
+    for (int scale : scales) {
+        bandOffsets.append(atlasHeight);
+        atlasHeight += rows * (flagSize * scale + CELL_PADDING);
+    }
+    const int atlasWidth = columns * (flagSize * maxScale + CELL_PADDING);
+
+    QImage atlas(atlasWidth, atlasHeight, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+
+    QPainter painter(&atlas);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+    int slot = 0;
+    for (auto it = flags.constBegin(); it != flags.constEnd(); ++it, ++slot) {
+        QSvgRenderer renderer(it.value());
+        if (!renderer.isValid()) {
+            err() << "flagatlasgen: cannot parse " << it.value() << "\n";
+            return 1;
+        }
+
+        for (int i = 0; i < scales.size(); ++i) {
+            const int cell = flagSize * scales[i];
+            const QRectF target((slot % columns) * (cell + CELL_PADDING),
+                                bandOffsets[i] + (slot / columns) * (cell + CELL_PADDING),
+                                cell, cell);
+            renderer.render(&painter, target);
+        }
+    }
+    painter.end();
+
+    QSaveFile imageFile(parser.value("out-image"));
+    if (!imageFile.open(QIODevice::WriteOnly) || !atlas.save(&imageFile, "PNG") || !imageFile.commit()) {
+        err() << "flagatlasgen: cannot write " << parser.value("out-image") << "\n";
+        return 1;
+    }
+
+    QSaveFile indexFile(parser.value("out-index"));
+    if (!indexFile.open(QIODevice::WriteOnly)) {
+        err() << "flagatlasgen: cannot write " << parser.value("out-index") << "\n";
+        return 1;
+    }
+
+    QDataStream out(&indexFile);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << ATLAS_MAGIC << ATLAS_VERSION
+        << quint16(flagSize) << quint16(columns) << quint16(CELL_PADDING)
+        << quint16(scales.size());
+    for (int i = 0; i < scales.size(); ++i) {
+        out << quint8(scales[i]) << quint32(bandOffsets[i]);
+    }
+    out << quint32(count);
+    for (auto it = flags.constBegin(); it != flags.constEnd(); ++it) {
+        out << it.key().toLatin1();
+    }
+
+    if (!indexFile.commit()) {
+        err() << "flagatlasgen: cannot write " << parser.value("out-index") << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,592 @@
+// svg2cpp - Build-time compiler from SVG icons to constexpr IconData tables
+//
+// Usage:
+//   svg2cpp --out-header generatedicons.h --out-source generatedicons.cpp
+//           arrow.svg check.svg close.svg minimize.svg panda.svg
+//
+// Understands the subset our icons use: <svg>/<g>/<path>, presentation
+// attributes and style="", fill/stroke colors (including currentColor),
+// stroke width/cap/join, fill-rule, and translate/scale/rotate/matrix
+// transforms. Path data is flattened to absolute move/line/cubic/close with
+// every transform applied. Anything else that would draw (rect, circle,
+// text, arcs, gradients, ...) fails the build instead of silently
+// disappearing from the icon.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QColor>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QPointF>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QTransform>
+#include <QXmlStreamReader>
+#include <cmath>
+#include "icondata.h"
+
+namespace {
+    QTextStream &err()
+    {
+        static QTextStream stream(stderr);
+        return stream;
+    }
+
+    struct PaintSpec {
+        IconData::Paint paint = IconData::Paint::None;
+        quint32 argb = 0;
+    };
+
+    // Inherited presentation state at one level of the element tree
+    struct Style {
+        PaintSpec fill{IconData::Paint::Color, 0xff000000};
+        PaintSpec stroke;
+        float strokeWidth = 1.0f;
+        IconData::Cap cap = IconData::Cap::Flat;
+        IconData::Join join = IconData::Join::Miter;
+        bool windingFill = true;
+        QTransform transform;
+    };
+
+    struct Command {
+        IconData::Op op;
+        QList<QPointF> points;
+    };
+
+    struct Shape {
+        QList<Command> commands;
+        Style style;
+    };
+
+    struct Icon {
+        QString fileName;
+        QString identifier;
+        float width = 0;
+        float height = 0;
+        QList<Shape> shapes;
+    };
+
+    class ParseError
+    {
+    public:
+        explicit ParseError(const QString &message) : m_message(message) {}
+        QString message() const { return m_message; }
+
+    private:
+        QString m_message;
+    };
+
+    bool parsePaint(const QString &value, PaintSpec *paint)
+    {
+        const QString v = value.trimmed();
+        if (v == "none") {
+            *paint = PaintSpec{IconData::Paint::None, 0};
+        } else if (v == "currentColor") {
+            *paint = PaintSpec{IconData::Paint::CurrentColor, 0};
+        } else if (v.startsWith("url(")) {
+            throw ParseError("gradients and patterns are not supported: " + v);
+        } else {
+            const QColor color = QColor::fromString(v);
+            if (!color.isValid()) return false;
+            *paint = PaintSpec{IconData::Paint::Color, color.rgba()};
+        }
+        return true;
+    }
+
+    QList<double> parseNumberList(const QString &text)
+    {
+        static const QRegularExpression numberRe("[-+]?(?:\\d+\\.?\\d*|\\.\\d+)(?:[eE][-+]?\\d+)?");
+        QList<double> numbers;
+        auto it = numberRe.globalMatch(text);
+        while (it.hasNext()) {
+            numbers.append(it.next().captured().toDouble());
+        }
+        return numbers;
+    }
+
+    QTransform parseTransform(const QString &text)
+    {
+        static const QRegularExpression opRe("(\\w+)\\s*\\(([^)]*)\\)");
+        QTransform result;
+        auto it = opRe.globalMatch(text);
+        while (it.hasNext()) {
+            const auto match = it.next();
+            const QString name = match.captured(1);
+            const QList<double> a = parseNumberList(match.captured(2));
+            QTransform t;
+            if (name == "translate" && !a.isEmpty()) {
+                t.translate(a[0], a.size() > 1 ? a[1] : 0);
+            } else if (name == "scale" && !a.isEmpty()) {
+                t.scale(a[0], a.size() > 1 ? a[1] : a[0]);
+            } else if (name == "rotate" && !a.isEmpty()) {
+                if (a.size() == 3) t.translate(a[1], a[2]);
+                t.rotate(a[0]);
+                if (a.size() == 3) t.translate(-a[1], -a[2]);
+            } else if (name == "matrix" && a.size() == 6) {
+                t = QTransform(a[0], a[1], a[2], a[3], a[4], a[5]);
+            } else {
+                throw ParseError("unsupported transform: " + match.captured(0));
+            }
+            // SVG applies the rightmost operation first
+            result = t * result;
+        }
+        return result;
+    }
+
+    void applyProperty(const QString &name, const QString &value, Style *style)
+    {
+        const QString v = value.trimmed();
+        if (name == "fill") {
+            if (!parsePaint(v, &style->fill)) throw ParseError("invalid fill: " + v);
+        } else if (name == "stroke") {
+            if (!parsePaint(v, &style->stroke)) throw ParseError("invalid stroke: " + v);
+        } else if (name == "stroke-width") {
+            style->strokeWidth = v.chopped(v.endsWith("px") ? 2 : 0).toFloat();
+        } else if (name == "stroke-linecap") {
+            style->cap = v == "round" ? IconData::Cap::Round
+                       : v == "square" ? IconData::Cap::Square : IconData::Cap::Flat;
+        } else if (name == "stroke-linejoin") {
+            style->join = v == "round" ? IconData::Join::Round
+                        : v == "bevel" ? IconData::Join::Bevel : IconData::Join::Miter;
+        } else if (name == "fill-rule") {
+            style->windingFill = v != "evenodd";
+        } else if (name == "opacity" || name == "fill-opacity" || name == "stroke-opacity") {
+            if (v.toDouble() < 1.0) throw ParseError("opacity is not supported: " + name + "=" + v);
+        }
+    }
+
+    Style resolveStyle(const QXmlStreamAttributes &attributes, const Style &parent)
+    {
+        Style style = parent;
+        for (const QXmlStreamAttribute &attribute : attributes) {
+            if (attribute.namespaceUri().isEmpty() && attribute.name() != u"style") {
+                applyProperty(attribute.name().toString(), attribute.value().toString(), &style);
+            }
+        }
+        // style="" wins over presentation attributes
+        const QStringList declarations = attributes.value("style").toString().split(';', Qt::SkipEmptyParts);
+        for (const QString &declaration : declarations) {
+            const qsizetype colon = declaration.indexOf(':');
+            if (colon > 0) {
+                applyProperty(declaration.left(colon).trimmed(), declaration.mid(colon + 1), &style);
+            }
+        }
+        if (attributes.hasAttribute("transform")) {
+            style.transform = parseTransform(attributes.value("transform").toString()) * parent.transform;
+        }
+        return style;
+    }
+
+    // PathDataParser - Turns SVG path data into absolute move/line/cubic/close
+    class PathDataParser
+    {
+    public:
+        explicit PathDataParser(const QString &data) : m_data(data), m_pos(0) {}
+
+        QList<Command> parse()
+        {
+            QChar command;
+            while (skipSeparators()) {
+                const QChar c = m_data.at(m_pos);
+                if (c.isLetter() && c != 'e' && c != 'E') {
+                    command = c;
+                    ++m_pos;
+                } else if (command.isNull() || command == 'Z' || command == 'z') {
+                    throw ParseError(QString("unexpected number at offset %1").arg(m_pos));
+                }
+                handle(command);
+                // Extra coordinate pairs after a moveto are implicit linetos
+                if (command == 'M') command = 'L';
+                else if (command == 'm') command = 'l';
+            }
+            return m_commands;
+        }
+
+    private:
+        bool skipSeparators()
+        {
+            while (m_pos < m_data.size() && (m_data.at(m_pos).isSpace() || m_data.at(m_pos) == ',')) ++m_pos;
+            return m_pos < m_data.size();
+        }
+
+        double number()
+        {
+            static const QRegularExpression numberRe("[-+]?(?:\\d+\\.?\\d*|\\.\\d+)(?:[eE][-+]?\\d+)?");
+            skipSeparators();
+            const auto match = numberRe.match(m_data, m_pos, QRegularExpression::NormalMatch,
+                                              QRegularExpression::AnchorAtOffsetMatchOption);
+            if (!match.hasMatch()) {
+                throw ParseError(QString("expected a number at offset %1").arg(m_pos));
+            }
+            m_pos = match.capturedEnd();
+            return match.captured().toDouble();
+        }
+
+        QPointF point(bool relative)
+        {
+            const double x = number();
+            const double y = number();
+            return relative ? m_current + QPointF(x, y) : QPointF(x, y);
+        }
+
+        void emitCommand(IconData::Op op, const QList<QPointF> &points)
+        {
+            m_commands.append(Command{op, points});
+        }
+
+        void lineTo(const QPointF &p)
+        {
+            emitCommand(IconData::Op::LineTo, {p});
+            m_current = p;
+            m_lastControl = p;
+        }
+
+        void cubicTo(const QPointF &c1, const QPointF &c2, const QPointF &p)
+        {
+            emitCommand(IconData::Op::CubicTo, {c1, c2, p});
+            m_current = p;
+            m_lastControl = c2;
+        }
+
+        void quadTo(const QPointF &q, const QPointF &p)
+        {
+            // Exact degree elevation so the table only needs cubics
+            cubicTo(m_current + (q - m_current) * (2.0 / 3.0), p + (q - p) * (2.0 / 3.0), p);
+            m_lastQuadControl = q;
+        }
+
+        void handle(QChar command)
+        {
+            const bool relative = command.isLower();
+            const char op = command.toUpper().toLatin1();
+            const QChar previous = m_previous;
+            m_previous = command.toUpper();
+
+            switch (op) {
+            case 'M':
+                m_current = point(relative);
+                m_subpathStart = m_current;
+                m_lastControl = m_current;
+                emitCommand(IconData::Op::MoveTo, {m_current});
+                break;
+            case 'L':
+                lineTo(point(relative));
+                break;
+            case 'H': {
+                const double x = number();
+                lineTo(QPointF(relative ? m_current.x() + x : x, m_current.y()));
+                break;
+            }
+            case 'V': {
+                const double y = number();
+                lineTo(QPointF(m_current.x(), relative ? m_current.y() + y : y));
+                break;
+            }
+            case 'C': {
+                const QPointF c1 = point(relative);
+                const QPointF c2 = point(relative);
+                cubicTo(c1, c2, point(relative));
+                break;
+            }
+            case 'S': {
+                const QPointF c1 = (previous == 'C' || previous == 'S')
+                                       ? m_current * 2 - m_lastControl : m_current;
+                const QPointF c2 = point(relative);
+                cubicTo(c1, c2, point(relative));
+                break;
+            }
+            case 'Q': {
+                const QPointF q = point(relative);
+                quadTo(q, point(relative));
+                break;
+            }
+            case 'T': {
+                const QPointF q = (previous == 'Q' || previous == 'T')
+                                      ? m_current * 2 - m_lastQuadControl : m_current;
+                quadTo(q, point(relative));
+                break;
+            }
+            case 'Z':
+                emitCommand(IconData::Op::Close, {});
+                m_current = m_subpathStart;
+                m_lastControl = m_current;
+                break;
+            default:
+                throw ParseError(QString("unsupported path command '%1'").arg(command));
+            }
+        }
+
+        QString m_data;
+        qsizetype m_pos;
+        QList<Command> m_commands;
+        QPointF m_current;
+        QPointF m_subpathStart;
+        QPointF m_lastControl;
+        QPointF m_lastQuadControl;
+        QChar m_previous;
+    };
+
+    QString identifierFor(const QString &fileName)
+    {
+        QString id = QFileInfo(fileName).completeBaseName().toUpper();
+        id.replace(QRegularExpression("[^A-Z0-9]"), "_");
+        if (id.isEmpty() || id.at(0).isDigit()) id.prepend('_');
+        return id;
+    }
+
+    Icon parseIcon(const QString &path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw ParseError("cannot open file");
+        }
+
+        Icon icon;
+        icon.fileName = QFileInfo(path).fileName();
+        icon.identifier = identifierFor(path);
+
+        static const QSet<QString> ignored = {"defs", "title", "desc", "metadata", "namedview"};
+        static const QSet<QString> containers = {"svg", "g"};
+
+        QXmlStreamReader xml(&file);
+        QList<Style> stack;
+        int skipDepth = 0;
+        while (!xml.atEnd()) {
+            const auto token = xml.readNext();
+            if (token == QXmlStreamReader::EndElement) {
+                if (skipDepth > 0) --skipDepth;
+                else if (!stack.isEmpty()) stack.removeLast();
+                continue;
+            }
+            if (token != QXmlStreamReader::StartElement) continue;
+            if (skipDepth > 0) {
+                ++skipDepth;
+                continue;
+            }
+
+            const QString name = xml.name().toString();
+            const bool foreign = xml.namespaceUri() != u"http://www.w3.org/2000/svg";
+            if (foreign || ignored.contains(name)) {
+                skipDepth = 1;
+                continue;
+            }
+
+            const Style parent = stack.isEmpty() ? Style() : stack.last();
+            if (name == "svg" && stack.isEmpty()) {
+                const QList<double> viewBox = parseNumberList(xml.attributes().value("viewBox").toString());
+                if (viewBox.size() == 4) {
+                    icon.width = viewBox[2];
+                    icon.height = viewBox[3];
+                    Style root = resolveStyle(xml.attributes(), parent);
+                    root.transform = root.transform * QTransform::fromTranslate(-viewBox[0], -viewBox[1]);
+                    stack.append(root);
+                } else {
+                    icon.width = parseNumberList(xml.attributes().value("width").toString()).value(0);
+                    icon.height = parseNumberList(xml.attributes().value("height").toString()).value(0);
+                    stack.append(resolveStyle(xml.attributes(), parent));
+                }
+            } else if (containers.contains(name)) {
+                stack.append(resolveStyle(xml.attributes(), parent));
+            } else if (name == "path") {
+                const Style style = resolveStyle(xml.attributes(), parent);
+                stack.append(style);
+
+                Shape shape;
+                shape.style = style;
+                shape.commands = PathDataParser(xml.attributes().value("d").toString()).parse();
+                for (Command &command : shape.commands) {
+                    for (QPointF &p : command.points) p = style.transform.map(p);
+                }
+                if (style.fill.paint != IconData::Paint::None || style.stroke.paint != IconData::Paint::None) {
+                    icon.shapes.append(shape);
+                }
+            } else {
+                throw ParseError("unsupported element <" + name + ">");
+            }
+        }
+
+        if (xml.hasError()) {
+            throw ParseError(xml.errorString());
+        }
+        if (icon.width <= 0 || icon.height <= 0) {
+            throw ParseError("missing viewBox or width/height");
+        }
+        if (icon.shapes.isEmpty()) {
+            throw ParseError("icon draws nothing");
+        }
+        return icon;
+    }
+
+    QString floatLiteral(double value)
+    {
+        QString text = QString::number(value, 'g', 9);
+        if (!text.contains('.') && !text.contains('e')) text += ".0";
+        return text + "f";
+    }
+
+    const char *paintName(IconData::Paint paint)
+    {
+        switch (paint) {
+        case IconData::Paint::Color: return "IconData::Paint::Color";
+        case IconData::Paint::CurrentColor: return "IconData::Paint::CurrentColor";
+        default: return "IconData::Paint::None";
+        }
+    }
+
+    const char *capName(IconData::Cap cap)
+    {
+        switch (cap) {
+        case IconData::Cap::Round: return "IconData::Cap::Round";
+        case IconData::Cap::Square: return "IconData::Cap::Square";
+        default: return "IconData::Cap::Flat";
+        }
+    }
+
+    const char *joinName(IconData::Join join)
+    {
+        switch (join) {
+        case IconData::Join::Round: return "IconData::Join::Round";
+        case IconData::Join::Bevel: return "IconData::Join::Bevel";
+        default: return "IconData::Join::Miter";
+        }
+    }
+
+    const char *opName(IconData::Op op)
+    {
+        switch (op) {
+        case IconData::Op::MoveTo: return "IconData::Op::MoveTo";
+        case IconData::Op::LineTo: return "IconData::Op::LineTo";
+        case IconData::Op::CubicTo: return "IconData::Op::CubicTo";
+        default: return "IconData::Op::Close";
+        }
+    }
+
+    QString generateHeader(const QList<Icon> &icons, const QStringList &inputs)
+    {
+        QString text;
+        QTextStream out(&text);
+        out << "// Generated by svg2cpp from " << inputs.join(", ") << " - do not edit\n\n"
+            << "#ifndef GENERATEDICONS_H\n#define GENERATEDICONS_H\n\n"
+            << "#include <QStringView>\n#include \"icondata.h\"\n\n"
+            << "namespace GeneratedIcons {\n";
+        for (const Icon &icon : icons) {
+            out << "    extern const IconData::Icon " << icon.identifier << ";\n";
+        }
+        out << "\n    // Looks an icon up by its source file name; null if it was not compiled in\n"
+            << "    const IconData::Icon *find(QStringView fileName);\n"
+            << "}\n\n#endif // GENERATEDICONS_H\n";
+        return text;
+    }
+
+    QString generateSource(const QList<Icon> &icons, const QString &headerName)
+    {
+        QString text;
+        QTextStream out(&text);
+        out << "// Generated by svg2cpp - do not edit\n\n"
+            << "#include \"" << headerName << "\"\n\n"
+            << "namespace GeneratedIcons {\n\nnamespace {\n";
+
+        for (const Icon &icon : icons) {
+            for (int s = 0; s < icon.shapes.size(); ++s) {
+                out << "constexpr IconData::Command " << icon.identifier << "_PATH" << s << "[] = {\n";
+                for (const Command &command : icon.shapes[s].commands) {
+                    out << "    {" << opName(command.op) << ", {";
+                    for (int i = 0; i < command.points.size(); ++i) {
+                        if (i) out << ", ";
+                        out << floatLiteral(command.points[i].x()) << ", " << floatLiteral(command.points[i].y());
+                    }
+                    out << "}},\n";
+                }
+                out << "};\n";
+            }
+
+            out << "constexpr IconData::Shape " << icon.identifier << "_SHAPES[] = {\n";
+            for (int s = 0; s < icon.shapes.size(); ++s) {
+                const Shape &shape = icon.shapes[s];
+                out << "    {" << icon.identifier << "_PATH" << s << ", " << shape.commands.size() << ", "
+                    << (shape.style.windingFill ? "true" : "false") << ", "
+                    << paintName(shape.style.fill.paint) << ", 0x"
+                    << QString::number(shape.style.fill.argb, 16) << "u, "
+                    << paintName(shape.style.stroke.paint) << ", 0x"
+                    << QString::number(shape.style.stroke.argb, 16) << "u, "
+                    << floatLiteral(shape.style.strokeWidth * std::sqrt(std::abs(shape.style.transform.determinant())))
+                    << ", " << capName(shape.style.cap) << ", " << joinName(shape.style.join) << "},\n";
+            }
+            out << "};\n\n";
+        }
+        out << "} // namespace\n\n";
+
+        for (const Icon &icon : icons) {
+            out << "constexpr IconData::Icon " << icon.identifier << " = {\"" << icon.fileName << "\", "
+                << floatLiteral(icon.width) << ", " << floatLiteral(icon.height) << ", "
+                << icon.identifier << "_SHAPES, " << icon.shapes.size() << "};\n";
+        }
+
+        out << "\nconst IconData::Icon *find(QStringView fileName)\n{\n"
+            << "    static constexpr const IconData::Icon *ICONS[] = {";
+        for (int i = 0; i < icons.size(); ++i) {
+            out << (i ? ", " : "") << "&" << icons[i].identifier;
+        }
+        out << "};\n"
+            << "    for (const IconData::Icon *icon : ICONS) {\n"
+            << "        if (fileName == QLatin1StringView(icon->name)) return icon;\n"
+            << "    }\n"
+            << "    return nullptr;\n}\n\n} // namespace GeneratedIcons\n";
+        return text;
+    }
+
+    bool writeFile(const QString &path, const QString &contents)
+    {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(contents.toUtf8()) < 0 || !file.commit()) {
+            err() << "svg2cpp: cannot write " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"out-header", "Header to write.", "file"});
+    parser.addOption({"out-source", "Source file to write.", "file"});
+    parser.addPositionalArgument("svg", "SVG icons to compile.", "<svg>...");
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (!parser.isSet("out-header") || !parser.isSet("out-source") || inputs.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    QList<Icon> icons;
+    QSet<QString> identifiers;
+    QStringList names;
+    for (const QString &input : inputs) {
+        try {
+            Icon icon = parseIcon(input);
+            if (identifiers.contains(icon.identifier)) {
+                throw ParseError("duplicate icon name " + icon.identifier);
+            }
+            identifiers.insert(icon.identifier);
+            names.append(icon.fileName);
+            icons.append(std::move(icon));
+        } catch (const ParseError &error) {
+            err() << "svg2cpp: " << input << ": " << error.message() << "\n";
+            return 1;
+        }
+    }
+
+    const QString headerPath = parser.value("out-header");
+    if (!writeFile(headerPath, generateHeader(icons, names))
+        || !writeFile(parser.value("out-source"), generateSource(icons, QFileInfo(headerPath).fileName()))) {
+        return 1;
+    }
+    return 0;
+}